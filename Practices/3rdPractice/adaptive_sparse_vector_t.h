@@ -0,0 +1,479 @@
+#ifndef ADAPTIVE_SPARSE_VECTORT_H_
+#define ADAPTIVE_SPARSE_VECTORT_H_
+
+#include <iostream>
+#include <cassert>
+#include <stdint.h>  // uint64_t
+
+#include "vector_t.h"
+#include "sparse_vector_t.h"
+
+// Above this density (nz / n) the dense layout is used even if a
+// compressed one would be a bit smaller: O(1) access is worth it
+#define ADAPTIVE_DENSE_DENSITY 0.5
+
+// Possible layouts of an adaptive_sparse_vector_t
+enum storage_t { DENSE_STORAGE, PAIRS_STORAGE, BITMAP_STORAGE };
+
+// Vector that picks its own layout from its density and the bytes each
+// layout would take:
+//
+//   DENSE  -> n_ doubles, zeros included (what vector_t<double> does)
+//   PAIRS  -> nz_ (index, value) pairs (what sparse_vector_t does)
+//   BITMAP -> 1 bit per position + per-word rank + nz_ packed doubles
+//
+// The layout is chosen again after every constructor and arithmetic
+// operation, so callers never have to convert by hand.
+class adaptive_sparse_vector_t {
+ public:
+  // -- Constructors --
+
+  adaptive_sparse_vector_t(const int = 0);
+  adaptive_sparse_vector_t(const vector_t<double>&, const double = EPS);
+  adaptive_sparse_vector_t(const sparse_vector_t&);
+
+  // -- Destructor --
+
+  ~adaptive_sparse_vector_t() {}
+
+  // -- Getters --
+
+  int get_n(void) const { return n_; }
+  int get_nz(void) const { return nz_; }
+  double get_val(const int) const;  // value at original index (0 if absent)
+
+  // -- Monitoring --
+
+  storage_t get_storage(void) const { return storage_; }
+  const char* get_storage_name(void) const;
+  long get_bytes(void) const;  // bytes held by the current layout
+
+  // -- Conversions --
+
+  void adapt(void);                 // re-pick the cheapest layout
+  void convert(const storage_t);    // force a layout
+  vector_t<double> to_dense(void) const;
+  sparse_vector_t to_sparse(void) const;
+
+  // -- Arithmetic (layout is re-picked afterwards) --
+
+  void add(const adaptive_sparse_vector_t&, const double = EPS);
+  void scale(const double, const double = EPS);
+  double dot(const adaptive_sparse_vector_t&) const;
+
+  // -- I/O --
+
+  void write(std::ostream& = std::cout) const;
+
+ private:
+  storage_t storage_;
+  int n_;             // size of original vector
+  int nz_;            // number of non-zero values
+
+  vector_t<double> dense_;     // DENSE: every position
+  pair_vector_t pv_;           // PAIRS: values + indices
+  vector_t<uint64_t> bits_;    // BITMAP: 1 bit per position
+  vector_t<int> rank_;         // BITMAP: non-zeros before each word
+  vector_t<double> packed_;    // BITMAP: non-zero values in index order
+
+  static int words(const int n) { return (n + 63) / 64; }
+  static long bytes(const storage_t, const int, const int);
+  storage_t choose(void) const;
+
+  bool next_nz(int&, int&, int&, double&) const;
+  void assign(const pair_vector_t&, const int, const storage_t);
+  void release(void);
+};
+
+// Bytes that a vector of size n with nz non-zeros takes in each layout
+long adaptive_sparse_vector_t::bytes(const storage_t s, const int n, const int nz)
+{
+  switch (s)
+  {
+    case DENSE_STORAGE:
+      return (long)n * sizeof(double);
+    case PAIRS_STORAGE:
+      return (long)nz * sizeof(pair_double_t);
+    default:
+      return (long)words(n) * (sizeof(uint64_t) + sizeof(int)) +
+             (long)nz * sizeof(double);
+  }
+}
+
+// Dense wins on density alone, otherwise the smaller compressed layout
+storage_t adaptive_sparse_vector_t::choose() const
+{
+  if (n_ == 0 || nz_ >= ADAPTIVE_DENSE_DENSITY * n_ ||
+      bytes(DENSE_STORAGE, n_, nz_) <= bytes(BITMAP_STORAGE, n_, nz_))
+    return DENSE_STORAGE;
+
+  return bytes(BITMAP_STORAGE, n_, nz_) < bytes(PAIRS_STORAGE, n_, nz_)
+             ? BITMAP_STORAGE : PAIRS_STORAGE;
+}
+
+// All zeros: no pairs yet, and adapt() moves to another layout if needed
+adaptive_sparse_vector_t::adaptive_sparse_vector_t(const int n)
+    : storage_(PAIRS_STORAGE), n_(n), nz_(0)
+{
+  adapt();
+}
+
+adaptive_sparse_vector_t::adaptive_sparse_vector_t(const vector_t<double>& v,
+                                                   const double eps)
+    : storage_(DENSE_STORAGE), n_(v.get_size()), nz_(0), dense_(v.get_size())
+{
+  // Start dense (the input already is) with near-zeros flushed, then adapt
+  for (int i = 0; i < n_; i++)
+  {
+    if (IsNotZero(v.at(i), eps))
+    {
+      dense_[i] = v.at(i);
+      nz_++;
+    }
+    else
+      dense_[i] = 0.0;
+  }
+
+  adapt();
+}
+
+adaptive_sparse_vector_t::adaptive_sparse_vector_t(const sparse_vector_t& sv)
+    : storage_(PAIRS_STORAGE), n_(sv.get_n()), nz_(sv.get_nz()), pv_(sv.get_nz())
+{
+  for (int i = 0; i < nz_; i++)
+    pv_[i] = sv.at(i);
+
+  adapt();
+}
+
+// Drops every layout's buffers
+void adaptive_sparse_vector_t::release()
+{
+  dense_.resize(0);
+  pv_.resize(0);
+  bits_.resize(0);
+  rank_.resize(0);
+  packed_.resize(0);
+}
+
+// Walks the non-zeros in index order whatever the layout is.
+// 'pos' and 'k' are the cursor state and must start at 0.
+bool adaptive_sparse_vector_t::next_nz(int& pos, int& k, int& inx, double& val) const
+{
+  switch (storage_)
+  {
+    case DENSE_STORAGE:
+      while (pos < n_ && dense_[pos] == 0.0)
+        pos++;
+      if (pos == n_)
+        return false;
+      inx = pos;
+      val = dense_[pos++];
+      return true;
+
+    case PAIRS_STORAGE:
+      if (k == nz_)
+        return false;
+      inx = pv_[k].get_inx();
+      val = pv_[k++].get_val();
+      return true;
+
+    default:
+    {
+      if (k == nz_)
+        return false;
+
+      // Next set bit at or after 'pos'
+      int w = pos / 64;
+      uint64_t b = bits_[w] & (~(uint64_t)0 << (pos % 64));
+      while (b == 0)
+        b = bits_[++w];
+
+      inx = w * 64 + __builtin_ctzll(b);
+      val = packed_[k++];
+      pos = inx + 1;
+      return true;
+    }
+  }
+}
+
+// Loads 'nz' sorted pairs into the requested layout
+void adaptive_sparse_vector_t::assign(const pair_vector_t& pv, const int nz,
+                                      const storage_t s)
+{
+  release();
+  storage_ = s;
+  nz_ = nz;
+
+  switch (s)
+  {
+    case DENSE_STORAGE:
+      dense_.resize(n_);
+      for (int i = 0; i < n_; i++)
+        dense_[i] = 0.0;
+      for (int j = 0; j < nz; j++)
+        dense_[pv[j].get_inx()] = pv[j].get_val();
+      break;
+
+    case PAIRS_STORAGE:
+      pv_.resize(nz);
+      for (int j = 0; j < nz; j++)
+        pv_[j] = pv[j];
+      break;
+
+    default:
+    {
+      const int nw = words(n_);
+      bits_.resize(nw);
+      rank_.resize(nw);
+      packed_.resize(nz);
+
+      for (int w = 0; w < nw; w++)
+        bits_[w] = 0;
+
+      for (int j = 0; j < nz; j++)
+      {
+        int i = pv[j].get_inx();
+        bits_[i / 64] |= (uint64_t)1 << (i % 64);
+        packed_[j] = pv[j].get_val();
+      }
+
+      // rank_[w] = number of set bits in the words before w
+      int acc = 0;
+      for (int w = 0; w < nw; w++)
+      {
+        rank_[w] = acc;
+        acc += __builtin_popcountll(bits_[w]);
+      }
+      break;
+    }
+  }
+}
+
+void adaptive_sparse_vector_t::convert(const storage_t s)
+{
+  pair_vector_t pv(nz_);
+  int pos = 0, k = 0, inx, j = 0;
+  double val;
+
+  while (next_nz(pos, k, inx, val))
+    pv[j++].set(val, inx);
+
+  assign(pv, nz_, s);
+}
+
+void adaptive_sparse_vector_t::adapt()
+{
+  storage_t s = choose();
+
+  // Nothing to move if the layout is already right (and allocated)
+  if (s != storage_ || (s == DENSE_STORAGE && dense_.get_size() != n_))
+    convert(s);
+}
+
+const char* adaptive_sparse_vector_t::get_storage_name() const
+{
+  switch (storage_)
+  {
+    case DENSE_STORAGE:
+      return "dense";
+    case PAIRS_STORAGE:
+      return "pairs";
+    default:
+      return "bitmap";
+  }
+}
+
+long adaptive_sparse_vector_t::get_bytes() const
+{
+  return bytes(storage_, n_, nz_);
+}
+
+double adaptive_sparse_vector_t::get_val(const int i) const
+{
+  assert(i >= 0 && i < n_);
+
+  switch (storage_)
+  {
+    case DENSE_STORAGE:
+      return dense_[i];
+
+    case PAIRS_STORAGE:
+    {
+      // Indices are sorted, so binary search
+      int lo = 0, hi = nz_ - 1;
+      while (lo <= hi)
+      {
+        int mid = (lo + hi) / 2;
+        int inx = pv_[mid].get_inx();
+        if (inx == i)
+          return pv_[mid].get_val();
+        if (inx < i)
+          lo = mid + 1;
+        else
+          hi = mid - 1;
+      }
+      return 0.0;
+    }
+
+    default:
+    {
+      uint64_t w = bits_[i / 64];
+      uint64_t bit = (uint64_t)1 << (i % 64);
+      if ((w & bit) == 0)
+        return 0.0;
+      return packed_[rank_[i / 64] + __builtin_popcountll(w & (bit - 1))];
+    }
+  }
+}
+
+vector_t<double> adaptive_sparse_vector_t::to_dense() const
+{
+  vector_t<double> v(n_);
+  for (int i = 0; i < n_; i++)
+    v[i] = 0.0;
+
+  int pos = 0, k = 0, inx;
+  double val;
+  while (next_nz(pos, k, inx, val))
+    v[inx] = val;
+
+  return v;
+}
+
+sparse_vector_t adaptive_sparse_vector_t::to_sparse() const
+{
+  if (storage_ == PAIRS_STORAGE)
+    return sparse_vector_t(pv_, n_);
+
+  pair_vector_t pv(nz_);
+  int pos = 0, k = 0, inx, j = 0;
+  double val;
+  while (next_nz(pos, k, inx, val))
+    pv[j++].set(val, inx);
+
+  return sparse_vector_t(pv, n_);
+}
+
+// this += w, merging both non-zero streams
+void adaptive_sparse_vector_t::add(const adaptive_sparse_vector_t& w, const double eps)
+{
+  assert(n_ == w.get_n());
+
+  pair_vector_t pv(nz_ + w.nz_);
+  int nz = 0;
+
+  int pos1 = 0, k1 = 0, inx1 = 0, pos2 = 0, k2 = 0, inx2 = 0;
+  double val1 = 0.0, val2 = 0.0;
+  bool more1 = next_nz(pos1, k1, inx1, val1);
+  bool more2 = w.next_nz(pos2, k2, inx2, val2);
+
+  while (more1 || more2)
+  {
+    int inx;
+    double val;
+
+    if (more1 && (!more2 || inx1 < inx2))
+    {
+      inx = inx1;
+      val = val1;
+      more1 = next_nz(pos1, k1, inx1, val1);
+    }
+    else if (more2 && (!more1 || inx2 < inx1))
+    {
+      inx = inx2;
+      val = val2;
+      more2 = w.next_nz(pos2, k2, inx2, val2);
+    }
+    else  // same index in both
+    {
+      inx = inx1;
+      val = val1 + val2;
+      more1 = next_nz(pos1, k1, inx1, val1);
+      more2 = w.next_nz(pos2, k2, inx2, val2);
+    }
+
+    if (IsNotZero(val, eps))
+      pv[nz++].set(val, inx);
+  }
+
+  nz_ = nz;
+  assign(pv, nz, choose());
+}
+
+// this *= a, dropping whatever falls under eps
+void adaptive_sparse_vector_t::scale(const double a, const double eps)
+{
+  pair_vector_t pv(nz_);
+  int pos = 0, k = 0, inx, nz = 0;
+  double val;
+
+  while (next_nz(pos, k, inx, val))
+    if (IsNotZero(a * val, eps))
+      pv[nz++].set(a * val, inx);
+
+  nz_ = nz;
+  assign(pv, nz, choose());
+}
+
+double adaptive_sparse_vector_t::dot(const adaptive_sparse_vector_t& w) const
+{
+  assert(n_ == w.get_n());
+
+  // If one side is dense, walk the other one and index directly
+  if (w.storage_ == DENSE_STORAGE || storage_ == DENSE_STORAGE)
+  {
+    const adaptive_sparse_vector_t& d = (w.storage_ == DENSE_STORAGE) ? w : *this;
+    const adaptive_sparse_vector_t& s = (w.storage_ == DENSE_STORAGE) ? *this : w;
+
+    double result = 0.0;
+    int pos = 0, k = 0, inx;
+    double val;
+    while (s.next_nz(pos, k, inx, val))
+      result += val * d.dense_[inx];
+    return result;
+  }
+
+  double result = 0.0;
+  int pos1 = 0, k1 = 0, inx1 = 0, pos2 = 0, k2 = 0, inx2 = 0;
+  double val1 = 0.0, val2 = 0.0;
+  bool more1 = next_nz(pos1, k1, inx1, val1);
+  bool more2 = w.next_nz(pos2, k2, inx2, val2);
+
+  while (more1 && more2)
+  {
+    if (inx1 < inx2)
+      more1 = next_nz(pos1, k1, inx1, val1);
+    else if (inx2 < inx1)
+      more2 = w.next_nz(pos2, k2, inx2, val2);
+    else
+    {
+      result += val1 * val2;
+      more1 = next_nz(pos1, k1, inx1, val1);
+      more2 = w.next_nz(pos2, k2, inx2, val2);
+    }
+  }
+
+  return result;
+}
+
+// I/O: same format as sparse_vector_t plus the layout in use
+void adaptive_sparse_vector_t::write(std::ostream& os) const
+{
+  os << get_n() << "(" << get_nz() << ", " << get_storage_name() << "): [ ";
+
+  int pos = 0, k = 0, inx;
+  double val;
+  while (next_nz(pos, k, inx, val))
+    os << pair_double_t(val, inx) << " ";
+
+  os << "]" << std::endl;
+}
+
+std::ostream& operator<<(std::ostream& os, const adaptive_sparse_vector_t& v)
+{
+  v.write(os);
+  return os;
+}
+
+#endif
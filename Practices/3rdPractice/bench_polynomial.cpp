@@ -0,0 +1,184 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+
+#include "polynomial.h"
+#include "polynomial_multipoint.h"
+#include "polynomial_roots.h"
+#include "polynomial_chebyshev.h"
+
+// Seconds per call of f, repeating it until at least 0.1 s have passed
+template<class F>
+double Time(F f)
+{
+  int reps = 0;
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  double elapsed = 0.0;
+
+  do
+  {
+    f();
+    reps++;
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  } while (elapsed < 0.1);
+
+  return elapsed / reps;
+}
+
+// Multiplication: the three kernels side by side, to place the
+// KaratsubaThreshold and FftThreshold crossovers on this machine
+void BenchMultiply()
+{
+  std::cout << "-- Multiply (us per product of two size-n polynomials) --" << std::endl;
+  std::cout << "n\tschoolbook\tkaratsuba\tfft" << std::endl;
+
+  for (int n = 8; n <= (1 << 15); n *= 2)
+  {
+    vector_t<double> a(n), b(n), out(2 * n - 1);
+    for (int i = 0; i < n; i++)
+    {
+      a[i] = rand() / (double)RAND_MAX - 0.5;
+      b[i] = rand() / (double)RAND_MAX - 0.5;
+    }
+
+    // Schoolbook is quadratic: stop timing it once it gets silly
+    double tsb = (n <= 8192) ? Time([&]() { MulSchoolbook(a.data(), n, b.data(), n, out.data()); }) : 0.0;
+    double tka = Time([&]() { MulKaratsuba(a.data(), n, b.data(), n, out.data()); });
+    double tff = Time([&]() { MulFFT(a.data(), n, b.data(), n, out.data()); });
+
+    std::cout << n << "\t" << tsb * 1e6 << "\t\t" << tka * 1e6 << "\t\t" << tff * 1e6 << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+// Largest |a[i] - b[i]| relative to the largest |a[i]| (NaN if any is)
+double RelativeError(const double* a, const double* b, const int n)
+{
+  double err = 0.0, scale = 0.0;
+  for (int i = 0; i < n; i++)
+  {
+    if (!(fabs(a[i] - b[i]) <= err))  // NaN sticks
+      err = fabs(a[i] - b[i]);
+    scale = fabs(a[i]) > scale ? fabs(a[i]) : scale;
+  }
+
+  return (scale > 0.0) ? err / scale : err;
+}
+
+// Evaluation of a degree n-1 polynomial at the n Chebyshev points of
+// [-1, 1]: EvalMany (Horner batches) against EvalChebyshevPoints. The
+// error is relative to EvalMany
+void BenchMultipoint()
+{
+  std::cout << "-- Multipoint evaluation (us for n points, degree n-1) --" << std::endl;
+  std::cout << "n	evalmany	chebyshev	chebyshev err" << std::endl;
+
+  for (int n = 8; n <= (1 << 15); n *= 2)
+  {
+    Polynomial pol(n);
+    for (int i = 0; i < n; i++)
+      pol[i] = rand() / (double)RAND_MAX - 0.5;
+
+    vector_t<double> xs(n), ref(n), cheb(n);
+    ChebyshevPoints(n, -1.0, 1.0, xs.data());
+
+    double tem = Time([&]() { pol.EvalMany(xs.data(), ref.data(), n); });
+    double tch = Time([&]() { EvalChebyshevPoints(pol, -1.0, 1.0, n, cheb.data()); });
+
+    std::cout << n << "\t" << tem * 1e6 << "\t\t" << tch * 1e6
+              << "\t\t" << RelativeError(ref.data(), cheb.data(), n) << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+// Roots of a batch of random polynomials of degree 20 to 60, on 1 to 8
+// threads. 'same' checks that every root comes out bit for bit as with
+// one thread
+void BenchRoots()
+{
+  std::cout << "-- Roots (batch of 2000 polynomials, degree 20-60) --" << std::endl;
+  std::cout << "threads	pols/s		failed	same" << std::endl;
+
+  const int count = 2000;
+  std::vector<Polynomial> pols;
+  for (int k = 0; k < count; k++)
+  {
+    Polynomial pol(21 + rand() % 41);
+    for (int i = 0; i < pol.get_size(); i++)
+      pol[i] = rand() / (double)RAND_MAX - 0.5;
+    pols.push_back(pol);
+  }
+
+  std::vector<std::vector<complex_t> > ref(count), roots(count);
+  FindRoots(pols.data(), count, ref.data(), 1);
+
+  for (int t = 1; t <= 8; t *= 2)
+  {
+    int failed = 0;
+    double secs = Time([&]() { failed = FindRoots(pols.data(), count, roots.data(), t); });
+
+    bool same = true;
+    for (int k = 0; k < count; k++)
+      same = same && roots[k] == ref[k];
+
+    std::cout << t << "\t" << count / secs << "\t\t" << failed << "\t"
+              << (same ? "yes" : "no") << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+// Evaluation at 4096 points of the same degree n-1 polynomial in both
+// bases: Horner (Polynomial::EvalMany) against Clenshaw
+// (ChebyshevPolynomial::EvalMany). Then the terms a Chebyshev fit of
+// e^x sin(3x) on [0, 2] keeps for a few accuracies
+void BenchChebyshev()
+{
+  std::cout << "-- Chebyshev basis (us for 4096 points, degree n-1) --" << std::endl;
+  std::cout << "n	horner		clenshaw" << std::endl;
+
+  const int points = 4096;
+  vector_t<double> xs(points), out(points);
+  for (int i = 0; i < points; i++)
+    xs[i] = 2.0 * rand() / RAND_MAX - 1.0;
+
+  for (int n = 8; n <= 512; n *= 4)
+  {
+    Polynomial pol(n);
+    for (int i = 0; i < n; i++)
+      pol[i] = rand() / (double)RAND_MAX - 0.5;
+    ChebyshevPolynomial cheb(pol);
+
+    double th = Time([&]() { pol.EvalMany(xs.data(), out.data(), points); });
+    double tc = Time([&]() { cheb.EvalMany(xs.data(), out.data(), points); });
+
+    std::cout << n << "\t" << th * 1e6 << "\t\t" << tc * 1e6 << std::endl;
+  }
+
+  const int n = 128;
+  vector_t<double> sx(n), sy(n);
+  ChebyshevPoints(n, 0.0, 2.0, sx.data());
+  for (int i = 0; i < n; i++)
+    sy[i] = exp(sx[i]) * sin(3 * sx[i]);
+
+  std::cout << "e^x sin(3x) on [0, 2], terms kept:";
+  for (double tol = 1e-4; tol >= 1e-13; tol *= 1e-4)
+  {
+    ChebyshevPolynomial fit(sy.data(), n, 0.0, 2.0);
+    std::cout << "  " << fit.Truncate(tol) << " (tol " << tol << ")";
+  }
+
+  std::cout << std::endl << std::endl;
+}
+
+int main()
+{
+  BenchMultiply();
+  BenchMultipoint();
+  BenchRoots();
+  BenchChebyshev();
+
+  return 0;
+}
@@ -0,0 +1,228 @@
+#ifndef COMPILED_POLYNOMIAL_H_
+#define COMPILED_POLYNOMIAL_H_
+
+#include <iostream>
+#include <cassert>
+
+#include "vector_t.h"
+#include "polynomial.h"
+
+// Coefficients per Estrin block (the tree below is written for 8)
+#define ESTRIN_BLOCK 8
+
+// Ways of evaluating a CompiledPolynomial
+enum eval_scheme_t {
+  HORNER_SCHEME,        // one dependent multiply-add per coefficient
+  SPLIT_HORNER_SCHEME,  // even and odd coefficients as two Horner chains in x²
+  ESTRIN_SCHEME         // blocks of 8 evaluated as a tree, chained in x⁸
+};
+
+// Polynomial "compiled" once for repeated evaluation. Horner is optimal
+// in operations but every step waits for the previous one; the other
+// schemes trade a few extra multiplies for independent work:
+//
+//   Estrin, 8 coefficients (3 levels, 4 + 2 + 1 independent steps):
+//
+//     (c0 + c1 x) + (c2 + c3 x) x²  +  ((c4 + c5 x) + (c6 + c7 x) x²) x⁴
+//
+// Longer polynomials are cut into blocks of 8 that are evaluated that way
+// and then combined with Horner in x⁸, so the dependent chain is only
+// degree/8 long. Coefficients are copied and zero-padded up front so the
+// evaluation loops have no data-dependent branches.
+class CompiledPolynomial {
+ public:
+  // constructors
+  CompiledPolynomial(const Polynomial&);
+  CompiledPolynomial(const SparsePolynomial&);
+  CompiledPolynomial(const Polynomial&, const eval_scheme_t);  // forced scheme
+
+  // destructor
+  ~CompiledPolynomial() {};
+
+  // getters
+  int get_degree(void) const { return degree_; }
+  eval_scheme_t get_scheme(void) const { return scheme_; }
+  const char* get_scheme_name(void) const;
+
+  // operations
+  double operator()(const double) const;
+  void operator()(const double*, double*, const int) const;
+
+ private:
+  eval_scheme_t scheme_;
+  int degree_;          // -1 for the zero polynomial
+  vector_t<double> c_;  // coefficients, zero-padded for the scheme
+
+  static int degree(const Polynomial&);
+  static eval_scheme_t choose(const int);
+  void compile(const Polynomial&, const eval_scheme_t);
+
+  double horner(const double) const;
+  double split_horner(const double) const;
+  double estrin(const double) const;
+};
+
+// Degree ignoring trailing zeros (-1 for the zero polynomial)
+int CompiledPolynomial::degree(const Polynomial& pol)
+{
+  int d = pol.get_size() - 1;
+  while (d >= 0 && pol[d] == 0.0)
+    d--;
+
+  return d;
+}
+
+// Plain Horner is already fine while the chain is short
+eval_scheme_t CompiledPolynomial::choose(const int degree)
+{
+  if (degree < 6)
+    return HORNER_SCHEME;
+  if (degree < 16)
+    return SPLIT_HORNER_SCHEME;
+  return ESTRIN_SCHEME;
+}
+
+CompiledPolynomial::CompiledPolynomial(const Polynomial& pol)
+{
+  compile(pol, choose(degree(pol)));
+}
+
+CompiledPolynomial::CompiledPolynomial(const SparsePolynomial& spol)
+{
+  // Goes dense: the schemes above need every power anyway
+  int n = (spol.get_nz() > 0) ? spol[spol.get_nz() - 1].get_inx() + 1 : 0;
+  Polynomial pol(n);
+
+  for (int i = 0; i < n; i++)
+    pol[i] = 0.0;
+  for (int k = 0; k < spol.get_nz(); k++)
+    pol[spol[k].get_inx()] = spol[k].get_val();
+
+  compile(pol, choose(degree(pol)));
+}
+
+CompiledPolynomial::CompiledPolynomial(const Polynomial& pol,
+                                       const eval_scheme_t scheme)
+{
+  compile(pol, scheme);
+}
+
+// Copies the coefficients, padded with zeros to what the scheme reads
+void CompiledPolynomial::compile(const Polynomial& pol, const eval_scheme_t scheme)
+{
+  scheme_ = scheme;
+  degree_ = degree(pol);
+
+  int n = degree_ + 1;
+  if (scheme_ == SPLIT_HORNER_SCHEME)
+    n = (n + 1) / 2 * 2;
+  else if (scheme_ == ESTRIN_SCHEME)
+    n = (n + ESTRIN_BLOCK - 1) / ESTRIN_BLOCK * ESTRIN_BLOCK;
+
+  c_.resize(n);
+  for (int i = 0; i < n; i++)
+    c_[i] = (i <= degree_) ? pol[i] : 0.0;
+}
+
+const char* CompiledPolynomial::get_scheme_name() const
+{
+  switch (scheme_)
+  {
+    case HORNER_SCHEME:
+      return "horner";
+    case SPLIT_HORNER_SCHEME:
+      return "split-horner";
+    default:
+      return "estrin";
+  }
+}
+
+double CompiledPolynomial::horner(const double x) const
+{
+  const double* c = c_.data();
+  double result = 0.0;
+
+  for (int i = c_.get_size() - 1; i >= 0; i--)
+    result = result * x + c[i];
+
+  return result;
+}
+
+// Two independent chains in x²: even coefficients and odd ones
+double CompiledPolynomial::split_horner(const double x) const
+{
+  const double* c = c_.data();
+  const double x2 = x * x;
+  double even = 0.0, odd = 0.0;
+
+  for (int i = c_.get_size() - 2; i >= 0; i -= 2)
+  {
+    even = even * x2 + c[i];
+    odd = odd * x2 + c[i + 1];
+  }
+
+  return even + odd * x;
+}
+
+double CompiledPolynomial::estrin(const double x) const
+{
+  const double* c = c_.data();
+  const double x2 = x * x;
+  const double x4 = x2 * x2;
+  const double x8 = x4 * x4;
+  double result = 0.0;
+
+  for (int b = c_.get_size() - ESTRIN_BLOCK; b >= 0; b -= ESTRIN_BLOCK)
+  {
+    const double* k = c + b;
+
+    double p01 = k[0] + k[1] * x;
+    double p23 = k[2] + k[3] * x;
+    double p45 = k[4] + k[5] * x;
+    double p67 = k[6] + k[7] * x;
+
+    double p03 = p01 + p23 * x2;
+    double p47 = p45 + p67 * x2;
+
+    result = result * x8 + (p03 + p47 * x4);
+  }
+
+  return result;
+}
+
+double CompiledPolynomial::operator()(const double x) const
+{
+  switch (scheme_)
+  {
+    case HORNER_SCHEME:
+      return horner(x);
+    case SPLIT_HORNER_SCHEME:
+      return split_horner(x);
+    default:
+      return estrin(x);
+  }
+}
+
+// Batch form: out[k] = p(xs[k]). The scheme is picked once outside the
+// loop, and the points are independent, so consecutive evaluations
+// overlap in the pipeline
+void CompiledPolynomial::operator()(const double* xs, double* out, const int n) const
+{
+  switch (scheme_)
+  {
+    case HORNER_SCHEME:
+      for (int k = 0; k < n; k++)
+        out[k] = horner(xs[k]);
+      break;
+    case SPLIT_HORNER_SCHEME:
+      for (int k = 0; k < n; k++)
+        out[k] = split_horner(xs[k]);
+      break;
+    default:
+      for (int k = 0; k < n; k++)
+        out[k] = estrin(xs[k]);
+      break;
+  }
+}
+
+#endif
@@ -0,0 +1,420 @@
+#ifndef COMPRESSED_SPARSE_VECTORT_H_
+#define COMPRESSED_SPARSE_VECTORT_H_
+
+#include <iostream>
+#include <cassert>
+#include <stdint.h>  // uint64_t
+
+#include "vector_t.h"
+#include "sparse_vector_t.h"
+
+// Indices per block. A block is the unit of random access
+#define CSV_BLOCK 128
+
+// Read-only sparse vector for huge sizes. Instead of one 'int' index per
+// non-zero (plus padding inside pair_t) the sorted indices are split into
+// blocks of CSV_BLOCK and stored as gaps:
+//
+//   indices:  1000  1003  1004  1010 | 5000  5001 ...
+//   skip:     first=1000 width=3     | first=5000 width=...
+//   gaps-1:         2     0     5    |          0 ...   (3 bits each)
+//
+// Each block packs its gaps with the smallest bit width that fits them,
+// so clustered indices take a couple of bits instead of 32. The skip
+// table (first index, width, word offset) lets a search or a cursor jump
+// straight to any block and decode only that one.
+class compressed_sparse_vector_t {
+ public:
+  // -- Constructors --
+
+  compressed_sparse_vector_t(void);
+  compressed_sparse_vector_t(const sparse_vector_t&);
+  compressed_sparse_vector_t(const long long*, const double*, const int,
+                             const long long);  // sorted indices, values, nz, n
+
+  // -- Destructor --
+
+  ~compressed_sparse_vector_t() {}
+
+  // -- Getters --
+
+  long long get_n(void) const { return n_; }
+  int get_nz(void) const { return nz_; }
+  int get_blocks(void) const { return first_.get_size(); }
+  long get_bytes(void) const;   // bytes of indices, values and skip table
+  double get_val(const long long) const;  // value at original index (0 if absent)
+
+  // -- Streaming access --
+
+  // Forward cursor that decodes one block at a time
+  class cursor {
+   public:
+    cursor(const compressed_sparse_vector_t&);
+
+    bool next(long long&, double&);   // next non-zero, false at the end
+    bool seek(const long long, long long&, double&);  // first non-zero >= target
+
+   private:
+    const compressed_sparse_vector_t& v_;
+    int block_;                  // block loaded in buf_ (-1 = none)
+    int k_;                      // next position inside buf_
+    int count_;                  // entries in buf_
+    long long buf_[CSV_BLOCK];
+
+    void load(const int);
+  };
+
+  // -- Operations --
+
+  double dot(const double*) const;  // dense operand of size n_
+  double dot(const sparse_vector_t&) const;
+  double dot(const compressed_sparse_vector_t&) const;
+
+  // -- I/O --
+
+  void write(std::ostream& = std::cout) const;
+
+ private:
+  long long n_;                   // size of original vector
+  int nz_;                        // number of non-zero values
+
+  vector_t<uint64_t> stream_;     // bit-packed gaps of every block
+  vector_t<double> val_;          // values, in index order
+  vector_t<long long> first_;     // skip table: first index of each block
+  vector_t<int> offset_;          // skip table: first word in stream_
+  vector_t<unsigned char> width_; // skip table: bits per gap
+
+  void build(const long long*, const double*);
+  int block_size(const int b) const;
+  int find_block(const long long) const;
+  void decode(const int, long long*) const;
+};
+
+// Bits needed to store x (0 for x == 0)
+inline int BitWidth(uint64_t x)
+{
+  return x == 0 ? 0 : 64 - __builtin_clzll(x);
+}
+
+compressed_sparse_vector_t::compressed_sparse_vector_t()
+    : n_(0), nz_(0) {}
+
+compressed_sparse_vector_t::compressed_sparse_vector_t(const sparse_vector_t& sv)
+    : n_(sv.get_n()), nz_(sv.get_nz())
+{
+  vector_t<long long> inx(nz_);
+  vector_t<double> val(nz_);
+
+  for (int i = 0; i < nz_; i++)
+  {
+    inx[i] = sv.at(i).get_inx();
+    val[i] = sv.at(i).get_val();
+  }
+
+  if (nz_ > 0)
+    build(&inx[0], &val[0]);
+}
+
+compressed_sparse_vector_t::compressed_sparse_vector_t(const long long* inx,
+                                                       const double* val,
+                                                       const int nz,
+                                                       const long long n)
+    : n_(n), nz_(nz)
+{
+  if (nz_ > 0)
+    build(inx, val);
+}
+
+// Two passes: size every block (bit width), then pack the gaps
+void compressed_sparse_vector_t::build(const long long* inx, const double* val)
+{
+  const int nb = (nz_ + CSV_BLOCK - 1) / CSV_BLOCK;
+
+  first_.resize(nb);
+  offset_.resize(nb);
+  width_.resize(nb);
+  val_.resize(nz_);
+
+  int words = 0;
+  for (int b = 0; b < nb; b++)
+  {
+    const int lo = b * CSV_BLOCK;
+    const int hi = lo + block_size(b);
+
+    assert(inx[lo] >= 0 && inx[hi - 1] < n_);
+
+    uint64_t max_gap = 0;
+    for (int i = lo + 1; i < hi; i++)
+    {
+      assert(inx[i - 1] < inx[i]);
+      uint64_t gap = inx[i] - inx[i - 1] - 1;
+      if (gap > max_gap)
+        max_gap = gap;
+    }
+
+    first_[b] = inx[lo];
+    width_[b] = BitWidth(max_gap);
+    offset_[b] = words;
+    words += ((hi - lo - 1) * width_[b] + 63) / 64;
+  }
+
+  stream_.resize(words);
+  for (int w = 0; w < words; w++)
+    stream_[w] = 0;
+
+  for (int b = 0; b < nb; b++)
+  {
+    const int lo = b * CSV_BLOCK;
+    const int hi = lo + block_size(b);
+    const int width = width_[b];
+    uint64_t* out = &stream_[0] + offset_[b];
+
+    for (int i = lo + 1; i < hi; i++)
+    {
+      uint64_t gap = inx[i] - inx[i - 1] - 1;
+      long bit = (long)(i - lo - 1) * width;
+      int off = bit % 64;
+
+      out[bit / 64] |= gap << off;
+      if (off + width > 64)
+        out[bit / 64 + 1] |= gap >> (64 - off);
+    }
+  }
+
+  for (int i = 0; i < nz_; i++)
+    val_[i] = val[i];
+}
+
+inline int compressed_sparse_vector_t::block_size(const int b) const
+{
+  return (b == first_.get_size() - 1) ? nz_ - b * CSV_BLOCK : CSV_BLOCK;
+}
+
+// Last block whose first index is <= i (-1 if none)
+int compressed_sparse_vector_t::find_block(const long long i) const
+{
+  int lo = 0, hi = first_.get_size() - 1, found = -1;
+
+  while (lo <= hi)
+  {
+    int mid = (lo + hi) / 2;
+    if (first_[mid] <= i)
+    {
+      found = mid;
+      lo = mid + 1;
+    }
+    else
+      hi = mid - 1;
+  }
+
+  return found;
+}
+
+// Unpacks block b into absolute indices. The unpack loop has no
+// dependency between iterations, only the final prefix sum does
+void compressed_sparse_vector_t::decode(const int b, long long* out) const
+{
+  const int count = block_size(b);
+  const int width = width_[b];
+  const uint64_t mask = (width == 64) ? ~(uint64_t)0
+                                      : (((uint64_t)1 << width) - 1);
+  const uint64_t* in = (stream_.get_size() > 0) ? &stream_[0] + offset_[b] : NULL;
+
+  out[0] = first_[b];
+  for (int k = 1; k < count; k++)
+  {
+    long bit = (long)(k - 1) * width;
+    int off = bit % 64;
+    uint64_t g = 0;
+
+    if (width > 0)
+    {
+      g = in[bit / 64] >> off;
+      if (off + width > 64)
+        g |= in[bit / 64 + 1] << (64 - off);
+    }
+    out[k] = (long long)(g & mask) + 1;
+  }
+
+  for (int k = 1; k < count; k++)
+    out[k] += out[k - 1];
+}
+
+long compressed_sparse_vector_t::get_bytes() const
+{
+  return (long)stream_.get_size() * sizeof(uint64_t) +
+         (long)val_.get_size() * sizeof(double) +
+         (long)first_.get_size() * (sizeof(long long) + sizeof(int) + 1);
+}
+
+double compressed_sparse_vector_t::get_val(const long long i) const
+{
+  assert(i >= 0 && i < n_);
+
+  int b = find_block(i);
+  if (b < 0)
+    return 0.0;
+
+  long long buf[CSV_BLOCK];
+  decode(b, buf);
+
+  int lo = 0, hi = block_size(b) - 1;
+  while (lo <= hi)
+  {
+    int mid = (lo + hi) / 2;
+    if (buf[mid] == i)
+      return val_[b * CSV_BLOCK + mid];
+    if (buf[mid] < i)
+      lo = mid + 1;
+    else
+      hi = mid - 1;
+  }
+
+  return 0.0;
+}
+
+// -- Cursor --
+
+compressed_sparse_vector_t::cursor::cursor(const compressed_sparse_vector_t& v)
+    : v_(v), block_(-1), k_(0), count_(0) {}
+
+void compressed_sparse_vector_t::cursor::load(const int b)
+{
+  block_ = b;
+  k_ = 0;
+  count_ = v_.block_size(b);
+  v_.decode(b, buf_);
+}
+
+bool compressed_sparse_vector_t::cursor::next(long long& inx, double& val)
+{
+  if (k_ == count_)
+  {
+    if (block_ + 1 >= v_.get_blocks())
+      return false;
+    load(block_ + 1);
+  }
+
+  inx = buf_[k_];
+  val = v_.val_[block_ * CSV_BLOCK + k_];
+  k_++;
+  return true;
+}
+
+// Moves forward to the first non-zero with index >= target. Blocks that
+// lie entirely before the target are skipped through the skip table
+// without being decoded
+bool compressed_sparse_vector_t::cursor::seek(const long long target,
+                                              long long& inx, double& val)
+{
+  int b = v_.find_block(target);
+  if (b > block_)
+    load(b);
+
+  while (next(inx, val))
+    if (inx >= target)
+      return true;
+
+  return false;
+}
+
+// -- Operations --
+
+double compressed_sparse_vector_t::dot(const double* x) const
+{
+  double result = 0.0;
+  long long buf[CSV_BLOCK];
+
+  for (int b = 0; b < get_blocks(); b++)
+  {
+    decode(b, buf);
+    const double* v = &val_[0] + b * CSV_BLOCK;
+    for (int k = 0; k < block_size(b); k++)
+      result += v[k] * x[buf[k]];
+  }
+
+  return result;
+}
+
+double compressed_sparse_vector_t::dot(const sparse_vector_t& w) const
+{
+  assert(n_ == w.get_n());
+
+  double result = 0.0;
+  cursor c(*this);
+  long long inx;
+  double val;
+  int j = 0;
+
+  if (!c.next(inx, val))
+    return 0.0;
+
+  while (j < w.get_nz())
+  {
+    long long wi = w.at(j).get_inx();
+
+    if (inx < wi)
+    {
+      if (!c.seek(wi, inx, val))
+        break;
+    }
+    else
+    {
+      if (inx == wi)
+        result += val * w.at(j).get_val();
+      j++;
+    }
+  }
+
+  return result;
+}
+
+double compressed_sparse_vector_t::dot(const compressed_sparse_vector_t& w) const
+{
+  assert(n_ == w.get_n());
+
+  double result = 0.0;
+  cursor c1(*this), c2(w);
+  long long inx1, inx2;
+  double val1, val2;
+
+  bool more = c1.next(inx1, val1) && c2.next(inx2, val2);
+
+  // Each side jumps to the other's index, skipping whole blocks
+  while (more)
+  {
+    if (inx1 < inx2)
+      more = c1.seek(inx2, inx1, val1);
+    else if (inx2 < inx1)
+      more = c2.seek(inx1, inx2, val2);
+    else
+    {
+      result += val1 * val2;
+      more = c1.next(inx1, val1) && c2.next(inx2, val2);
+    }
+  }
+
+  return result;
+}
+
+// I/O: same format as sparse_vector_t
+void compressed_sparse_vector_t::write(std::ostream& os) const
+{
+  os << get_n() << "(" << get_nz() << "): [ ";
+
+  cursor c(*this);
+  long long inx;
+  double val;
+  while (c.next(inx, val))
+    os << "(" << inx << ":" << val << ") ";
+
+  os << "]" << std::endl;
+}
+
+std::ostream& operator<<(std::ostream& os, const compressed_sparse_vector_t& v)
+{
+  v.write(os);
+  return os;
+}
+
+#endif
@@ -2,10 +2,18 @@
 #define POLYNOMIAL_H_
 
 #include <iostream>
-#include <math.h>  // fabs, pow
+#include <math.h>  // fabs
+#include <vector>
+#include <queue>   // std::priority_queue
 
 #include "vector_t.h"
 #include "sparse_vector_t.h"
+#include "power_table_t.h"
+#include "polynomial_multiply.h"
+#include "polynomial_division.h"
+
+// Points evaluated side by side by Polynomial::EvalMany
+#define EVAL_LANES 8
 
 // Class for polynomials based on dense vectors of doubles
 class Polynomial : public vector_t<double> {
@@ -23,7 +31,16 @@ class Polynomial : public vector_t<double> {
   
   // operations
   double Eval(const double) const;
+  void EvalMany(const double*, double*, const int) const;
   bool IsEqual(const Polynomial&, const double = EPS) const;
+  void Multiply(const Polynomial&, Polynomial&) const;
+  void DivMod(const Polynomial&, Polynomial&, Polynomial&,
+              const double = EPS) const;  // divisor, quotient, remainder
+  void Gcd(const Polynomial&, Polynomial&, const double = EPS) const;
+
+ private:
+  coef_t coefficients(const double) const;
+  void assign(const coef_t&);
 };
 
 // Class for polynomials based on sparse vectors
@@ -42,8 +59,11 @@ class SparsePolynomial : public sparse_vector_t {
   
   // operations
   double Eval(const double) const;
+  double Eval(const power_table_t&) const;  // x^(2^k) shared across calls
   bool IsEqual(const SparsePolynomial&, const double = EPS) const;
   bool IsEqual(const Polynomial&, const double = EPS) const;
+  void Multiply(const SparsePolynomial&, SparsePolynomial&,
+                const double = EPS) const;
 
   // Method for practice
   double AverageOfOddDegreeCoefficients() const;
@@ -82,15 +102,47 @@ std::ostream& operator<<(std::ostream& os, const Polynomial& p)
 double Polynomial::Eval(const double x) const
 {
   double result = 0.0;
-  int n = get_size();
 
-  // i_0 × x^0 + i_1 × x^1 + i_2 × x^2 + ... + i_n × x^n
-  for (int i = 0; i < n; i++)
+  // i_0 × x^0 + i_1 × x^1 + i_2 × x^2 + ... + i_n × x^n, but written
+  // Horner's way so there is no pow() and just one multiply-add per term:
+  //
+  //   (((i_n × x + i_{n-1}) × x + i_{n-2}) × x + ...) × x + i_0
+  for (int i = get_size() - 1; i >= 0; i--)
+    result = result * x + at(i);
+
+  return result;
+}
+
+// Evaluation at n points: out[k] = Eval(xs[k]).
+// EVAL_LANES points go through Horner together, so every coefficient is
+// loaded once per group and the lanes are independent multiply-adds the
+// compiler can put in SIMD registers (and that hide each other's latency
+// even when it does not)
+void Polynomial::EvalMany(const double* xs, double* out, const int n) const
+{
+  const double* c = data();
+  int k = 0;
+
+  for ( ; k + EVAL_LANES <= n; k += EVAL_LANES)
   {
-    result += at(i) * pow(x, i);
+    double x[EVAL_LANES], acc[EVAL_LANES];
+    for (int l = 0; l < EVAL_LANES; l++)
+    {
+      x[l] = xs[k + l];
+      acc[l] = 0.0;
+    }
+
+    for (int i = get_size() - 1; i >= 0; i--)
+      for (int l = 0; l < EVAL_LANES; l++)
+        acc[l] = acc[l] * x[l] + c[i];
+
+    for (int l = 0; l < EVAL_LANES; l++)
+      out[k + l] = acc[l];
   }
 
-  return result;
+  // Leftover points, one at a time
+  for ( ; k < n; k++)
+    out[k] = Eval(xs[k]);
 }
 
 // Comparison of two polynomials represented by dense vectors
@@ -112,6 +164,87 @@ bool Polynomial::IsEqual(const Polynomial& pol, const double eps) const
   return true;
 }
 
+// Product of two polynomials represented by dense vectors. 'prod' is
+// only reallocated if it does not already have the right size, so a
+// caller multiplying in a loop can keep reusing the same output.
+// The algorithm (schoolbook, Karatsuba or FFT) is chosen by PolyMul.
+void Polynomial::Multiply(const Polynomial& pol, Polynomial& prod) const
+{
+  if (get_size() == 0 || pol.get_size() == 0)
+  {
+    prod.resize(0);
+    return;
+  }
+
+  const int n = get_size() + pol.get_size() - 1;
+
+  // The kernels cannot write over their own inputs
+  if (&prod == this || &prod == &pol)
+  {
+    Polynomial aux(n);
+    PolyMul(data(), get_size(), pol.data(), pol.get_size(), aux.data());
+
+    if (prod.get_size() != n)
+      prod.resize(n);
+    for (int i = 0; i < n; i++)
+      prod[i] = aux[i];
+    return;
+  }
+
+  if (prod.get_size() != n)
+    prod.resize(n);
+
+  PolyMul(data(), get_size(), pol.data(), pol.get_size(), prod.data());
+}
+
+// Coefficients up to the last one that IsNotZero
+coef_t Polynomial::coefficients(const double eps) const
+{
+  coef_t c(data(), data() + get_size());
+  TrimCoef(c, eps);
+  return c;
+}
+
+void Polynomial::assign(const coef_t& c)
+{
+  if (get_size() != (int)c.size())
+    resize(c.size());
+  for (int i = 0; i < get_size(); i++)
+    at(i) = c[i];
+}
+
+// Division with remainder: *this = pol × quot + rem, deg(rem) < deg(pol).
+// Coefficients under eps do not count for the degrees, and quot and rem
+// come out trimmed to their degree (size 0 for the zero polynomial).
+// Long division is used while the quotient or the divisor are short;
+// past DivNewtonThreshold the quotient comes from a Newton inverse of
+// the reversed divisor, which costs a few products (see DivModNewton).
+// quot and rem may be the same objects as *this or pol
+void Polynomial::DivMod(const Polynomial& pol, Polynomial& quot, Polynomial& rem,
+                        const double eps) const
+{
+  coef_t b = pol.coefficients(eps);
+  assert(!b.empty());  // division by the zero polynomial
+
+  coef_t q, r;
+  DivModCoef(coefficients(eps), b, q, r, eps);
+
+  quot.assign(q);
+  rem.assign(r);
+}
+
+// Greatest common divisor, made monic (leading coefficient 1); the zero
+// polynomial if both are zero. Here eps is relative to the size of the
+// coefficients: the remainders are rescaled at every step (Euclid only,
+// see GcdCoef)
+void Polynomial::Gcd(const Polynomial& pol, Polynomial& gcd, const double eps) const
+{
+  coef_t g;
+  GcdCoef(coefficients(0.0), pol.coefficients(0.0), g, eps);
+
+  gcd.assign(g);
+}
+
 // Copy constructor
 SparsePolynomial::SparsePolynomial(const SparsePolynomial& spol)
 {
@@ -167,12 +300,46 @@ std::ostream& operator<<(std::ostream& os, const SparsePolynomial& p)
 double SparsePolynomial::Eval(const double x) const
 {
   double result = 0.0;
+  double power = 1.0;  // x^prev
+  power_anchor_t anchor(PowerSpan(x));
+
+  // Exponents are sorted, so instead of pow(x, index) for every term the
+  // power is carried forward: x^index = x^prev × x^(index - prev), and
+  // the gap power is done by squaring. For 2.5 + 4.0x^2 + 3.1x^6:
+  //
+  //   x^0 = 1,  x^2 = x^0 × x^2,  x^6 = x^2 × x^4
+  //
+  // power_anchor_t says when it is recomputed from scratch, so rounding
+  // does not pile up along long polynomials or wide gaps
   for (int i = 0; i < get_nz(); i++)
   {
-    // Similar to dense version but only considering non-zero elements
     int index = at(i).get_inx();
     double coef = at(i).get_val();
-    result += coef * pow(x, index);
+
+    power = anchor.step(index) ? AnchorPow(x, index)
+                               : power * GapPow(x, anchor.get_gap());
+
+    result += coef * power;
+  }
+
+  return result;
+}
+
+// Same walk, with the powers taken from a table built once for x
+double SparsePolynomial::Eval(const power_table_t& pt) const
+{
+  double result = 0.0;
+  double power = 1.0;
+  power_anchor_t anchor(PowerSpan(pt));
+
+  for (int i = 0; i < get_nz(); i++)
+  {
+    int index = at(i).get_inx();
+
+    power = anchor.step(index) ? AnchorPow(pt, index)
+                               : power * GapPow(pt, anchor.get_gap());
+
+    result += at(i).get_val() * power;
   }
 
   return result;
@@ -181,11 +348,22 @@ double SparsePolynomial::Eval(const double x) const
 // Comparison of two polynomials represented by sparse vectors
 bool SparsePolynomial::IsEqual(const SparsePolynomial& spol, const double eps) const
 {
-  for (int i = 0; i < get_nz(); i++)
+  int i = 0, j = 0;
+
+  // Merge both lists of terms: a term the other polynomial lacks has to
+  // be (close to) zero, like in the dense comparison
+  while (i < get_nz() || j < spol.get_nz())
   {
-    // Returns false if different index or value difference > eps
-    if (at(i).get_inx() != spol.at(i).get_inx() ||
-        fabs(at(i).get_val() - spol.at(i).get_val()) > eps)
+    int inx_i = (i < get_nz()) ? at(i).get_inx() : -1;
+    int inx_j = (j < spol.get_nz()) ? spol.at(j).get_inx() : -1;
+    double a = 0.0, b = 0.0;
+
+    if (inx_j < 0 || (inx_i >= 0 && inx_i <= inx_j))
+      a = at(i++).get_val();
+    if (inx_i < 0 || (inx_j >= 0 && inx_j <= inx_i))
+      b = spol.at(j++).get_val();
+
+    if (fabs(a - b) > eps)
       return false;
   }
 
@@ -220,6 +398,78 @@ bool SparsePolynomial::IsEqual(const Polynomial& pol, const double eps) const
   return true;
 }
 
+// Heap entry of the sparse product: term i of the shorter operand times
+// term j of the longer one, keyed by the exponent of that product
+struct product_term_t {
+  int inx;
+  int i, j;
+
+  // std::priority_queue is a max-heap: reversed to pop the smallest
+  bool operator<(const product_term_t& t) const { return inx > t.inx; }
+};
+
+// Product of two polynomials represented by sparse vectors, without any
+// dense buffer (Johnson's algorithm). Every term i of the shorter operand
+// s gives a sorted stream s_i × l_0, s_i × l_1, ... with the longer one l.
+// A heap holding the head of each stream pops the products in increasing
+// exponent order, so equal exponents come out together, are summed, and
+// the result is written already sorted:
+//
+//   (1 + 2x)(3 + x^2)   streams:  1×3, 1×x^2        heap pops:
+//                                 2x×3, 2x×x^2      3, 6x, x^2, 2x^3
+//
+// O(nz1 × nz2 × log(min(nz1, nz2))) time, O(min(nz1, nz2)) extra memory
+// besides the result. Sums under eps are dropped, as IsNotZero does.
+void SparsePolynomial::Multiply(const SparsePolynomial& spol, SparsePolynomial& prod,
+                                const double eps) const
+{
+  const SparsePolynomial& s = (get_nz() <= spol.get_nz()) ? *this : spol;
+  const SparsePolynomial& l = (get_nz() <= spol.get_nz()) ? spol : *this;
+
+  std::priority_queue<product_term_t> heap;
+  std::vector<pair_double_t> terms;
+
+  if (l.get_nz() > 0)
+    for (int i = 0; i < s.get_nz(); i++)
+    {
+      product_term_t t = { s[i].get_inx() + l[0].get_inx(), i, 0 };
+      heap.push(t);
+    }
+
+  while (!heap.empty())
+  {
+    const int inx = heap.top().inx;
+    double sum = 0.0;
+
+    // Every stream whose head has this exponent
+    while (!heap.empty() && heap.top().inx == inx)
+    {
+      product_term_t t = heap.top();
+      heap.pop();
+
+      sum += s[t.i].get_val() * l[t.j].get_val();
+
+      if (++t.j < l.get_nz())
+      {
+        t.inx = s[t.i].get_inx() + l[t.j].get_inx();
+        heap.push(t);
+      }
+    }
+
+    if (IsNotZero(sum, eps))
+      terms.push_back(pair_double_t(sum, inx));
+  }
+
+  pair_vector_t pv(terms.size());
+  for (int k = 0; k < pv.get_size(); k++)
+    pv[k] = terms[k];
+
+  const int n = (get_n() > 0 && spol.get_n() > 0) ? get_n() + spol.get_n() - 1 : 0;
+
+  // Written last, so prod may be one of the operands
+  static_cast<sparse_vector_t&>(prod) = sparse_vector_t(pv, n);
+}
+
 double SparsePolynomial::AverageOfOddDegreeCoefficients() const
 {
   double result = 0.0;
@@ -0,0 +1,248 @@
+#ifndef POLYNOMIAL_CHEBYSHEV_H_
+#define POLYNOMIAL_CHEBYSHEV_H_
+
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <math.h>  // fabs, cos, sin, acos
+
+#include "polynomial.h"
+#include "polynomial_multipoint.h"
+
+// Polynomials on [a, b] in the Chebyshev basis:
+//
+//   p(x) = c_0 T_0(t) + c_1 T_1(t) + ... + c_n-1 T_n-1(t),
+//   t = (2x - a - b) / (b - a),  T_k(cos θ) = cos(kθ)
+//
+// Every |T_k| <= 1 on [a, b], so a coefficient is also the most its term
+// can add anywhere on the interval. Small coefficients can be dropped
+// with a known error bound (Truncate), and evaluation does not suffer
+// the cancellations of large monomial coefficients of opposite signs.
+// For smooth functions the c_k decay fast, so few terms are needed.
+class ChebyshevPolynomial : public vector_t<double> {
+ public:
+  // constructors
+  ChebyshevPolynomial(const int n = 0, const double a = -1.0,
+                      const double b = 1.0)
+      : vector_t<double>(n), a_(a), b_(b) {};
+  ChebyshevPolynomial(const Polynomial&, const double a = -1.0,
+                      const double b = 1.0);
+  ChebyshevPolynomial(const double*, const int,  // samples, how many
+                      const double a = -1.0, const double b = 1.0);
+  ChebyshevPolynomial(const ChebyshevPolynomial& pol)
+      : vector_t<double>(pol), a_(pol.a_), b_(pol.b_) {}; // copy constructor
+
+  // destructor
+  ~ChebyshevPolynomial() {};
+
+  // getters
+  double get_a(void) const { return a_; }
+  double get_b(void) const { return b_; }
+
+  // I/O
+  void Write(std::ostream& = std::cout, const double eps = EPS) const;
+
+  // operations
+  double Eval(const double) const;
+  void EvalMany(const double*, double*, const int) const;
+  int Truncate(const double = EPS);  // returns the new size
+
+ private:
+  double a_, b_;  // the interval
+
+  double map(const double x) const { return (2 * x - a_ - b_) / (b_ - a_); }
+};
+
+// From the monomial basis. pol is first rewritten in t (ComposeAffine),
+// then turned into Chebyshev coefficients by Horner's rule in that
+// basis, using t T_0 = T_1 and t T_k = (T_k-1 + T_k+1) / 2:
+//
+//   s <- s × t + q_i,  from the highest coefficient down
+//
+// O(n²), but well conditioned: this is the direction in which the
+// coefficients do not blow up
+ChebyshevPolynomial::ChebyshevPolynomial(const Polynomial& pol, const double a,
+                                         const double b)
+    : vector_t<double>(), a_(a), b_(b)
+{
+  assert(b > a);
+
+  coef_t p(pol.data(), pol.data() + pol.get_size());
+  coef_t q = ComposeAffine(p, (a + b) / 2, (b - a) / 2);
+  const int n = q.size();
+
+  std::vector<double> s(n + 1, 0.0), aux(n + 1);
+  for (int i = n - 1, deg = -1; i >= 0; i--, deg++)
+  {
+    // aux = s × t, s of degree deg
+    for (int k = 0; k <= deg + 1; k++)
+      aux[k] = 0.0;
+    for (int k = 0; k <= deg; k++)
+      if (k == 0)
+        aux[1] += s[0];
+      else
+      {
+        aux[k - 1] += s[k] / 2;
+        aux[k + 1] += s[k] / 2;
+      }
+
+    for (int k = 0; k <= deg + 1; k++)
+      s[k] = aux[k];
+    s[0] += q[i];
+  }
+
+  resize(n);
+  for (int k = 0; k < n; k++)
+    at(k) = s[k];
+}
+
+// Interpolant of degree < n through the samples ys[i] = f(xs[i]) at the
+// n Chebyshev points of [a, b], as given by ChebyshevPoints. There the
+// coefficients are a discrete cosine transform of the samples:
+//
+//   c_k = (2 - [k = 0]) / n × Σ_i ys[i] cos(π k (2i + 1) / 2n)
+//
+// For n a power of 2 this is one complex FFT of size 2n, over the
+// samples followed by their mirror image; otherwise the sums are done
+// directly, in O(n²)
+ChebyshevPolynomial::ChebyshevPolynomial(const double* ys, const int n,
+                                         const double a, const double b)
+    : vector_t<double>(n), a_(a), b_(b)
+{
+  assert(b > a);
+
+  const double pi = acos(-1.0);
+
+  if (n > 0 && (n & (n - 1)) == 0)
+  {
+    const int nn = 2 * n;
+    std::vector<complex_t> z(nn), roots(n);
+    for (int i = 0; i < n; i++)
+      z[i] = z[nn - 1 - i] = ys[i];
+    for (int k = 0; k < n; k++)
+      roots[k] = complex_t(cos(2 * pi * k / nn), -sin(2 * pi * k / nn));
+
+    Fft(&z[0], nn, &roots[0], false);
+
+    // Z_k = 2 e^(iπk/2n) Σ_i ys[i] cos(πk(2i + 1)/2n)
+    for (int k = 0; k < n; k++)
+    {
+      const double t = pi * k / nn;
+      at(k) = (z[k].real() * cos(t) + z[k].imag() * sin(t)) / n;
+    }
+  }
+  else
+    for (int k = 0; k < n; k++)
+    {
+      double sum = 0.0;
+      for (int i = 0; i < n; i++)
+        sum += ys[i] * cos(pi * k * (2 * i + 1) / (2 * n));
+      at(k) = 2 * sum / n;
+    }
+
+  if (n > 0)
+    at(0) /= 2;
+}
+
+// I/O
+void ChebyshevPolynomial::Write(std::ostream& os, const double eps) const
+{
+  os << get_size() << ": [" << a_ << ", " << b_ << "] [ ";
+
+  bool first{true};
+  for (int i{0}; i < get_size(); i++)
+    if (IsNotZero(at(i), eps))
+    {
+      os << (!first ? " + " : "") << at(i) << " T" << i;
+      first = false;
+    }
+
+  os << " ]" << std::endl;
+}
+
+std::ostream& operator<<(std::ostream& os, const ChebyshevPolynomial& p)
+{
+  p.Write(os);
+  return os;
+}
+
+// Evaluation with Clenshaw's recurrence, the Horner of this basis:
+//
+//   b_k = c_k + 2t b_k+1 - b_k+2,  p(x) = c_0 + t b_1 - b_2
+//
+// one multiply-add and a subtraction per term, no T_k computed
+double ChebyshevPolynomial::Eval(const double x) const
+{
+  const double t = map(x);
+  double b1 = 0.0, b2 = 0.0;
+
+  for (int k = get_size() - 1; k >= 1; k--)
+  {
+    const double b0 = at(k) + 2 * t * b1 - b2;
+    b2 = b1;
+    b1 = b0;
+  }
+
+  return (get_size() > 0) ? at(0) + t * b1 - b2 : 0.0;
+}
+
+// Evaluation at n points, EVAL_LANES at a time like Polynomial::EvalMany:
+// the lanes run the recurrence side by side on each coefficient
+void ChebyshevPolynomial::EvalMany(const double* xs, double* out,
+                                   const int n) const
+{
+  const double* c = data();
+  const int m = get_size();
+  int k = 0;
+
+  for ( ; m > 0 && k + EVAL_LANES <= n; k += EVAL_LANES)
+  {
+    double t2[EVAL_LANES], b1[EVAL_LANES], b2[EVAL_LANES];
+    for (int l = 0; l < EVAL_LANES; l++)
+    {
+      t2[l] = 2 * map(xs[k + l]);
+      b1[l] = b2[l] = 0.0;
+    }
+
+    for (int i = m - 1; i >= 1; i--)
+      for (int l = 0; l < EVAL_LANES; l++)
+      {
+        const double b0 = c[i] + t2[l] * b1[l] - b2[l];
+        b2[l] = b1[l];
+        b1[l] = b0;
+      }
+
+    for (int l = 0; l < EVAL_LANES; l++)
+      out[k + l] = c[0] + t2[l] / 2 * b1[l] - b2[l];
+  }
+
+  // Leftover points, one at a time
+  for ( ; k < n; k++)
+    out[k] = Eval(xs[k]);
+}
+
+// Drops the highest coefficients as long as the sum of their absolute
+// values stays within tol, so the result differs from the original by
+// at most tol anywhere on [a, b]
+int ChebyshevPolynomial::Truncate(const double tol)
+{
+  int m = get_size();
+  double tail = 0.0;
+  while (m > 0 && tail + fabs(at(m - 1)) <= tol)
+  {
+    tail += fabs(at(m - 1));
+    m--;
+  }
+
+  if (m < get_size())
+  {
+    std::vector<double> keep(data(), data() + m);
+    resize(m);
+    for (int k = 0; k < m; k++)
+      at(k) = keep[k];
+  }
+
+  return m;
+}
+
+#endif
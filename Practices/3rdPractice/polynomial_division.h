@@ -0,0 +1,205 @@
+#ifndef POLYNOMIAL_DIVISION_H_
+#define POLYNOMIAL_DIVISION_H_
+
+#include <cassert>
+#include <vector>
+#include <math.h>  // fabs
+
+#include "polynomial_multiply.h"
+
+// Crossovers, in coefficients. Same idea as KaratsubaThreshold
+int DivNewtonThreshold = 1024;  // quotient and divisor both this long -> Newton
+
+// Coefficients, lowest degree first. Trimmed so the last one is non-zero
+// (the zero polynomial is empty)
+typedef std::vector<double> coef_t;
+
+// Drops leading coefficients that are not IsNotZero(·, eps)
+void TrimCoef(coef_t& p, const double eps)
+{
+  while (!p.empty() && fabs(p.back()) <= eps)
+    p.pop_back();
+}
+
+// p / max|p_i|, so that an absolute eps means the same at every step
+void NormalizeCoef(coef_t& p)
+{
+  double m = 0.0;
+  for (size_t i = 0; i < p.size(); i++)
+    m = fabs(p[i]) > m ? fabs(p[i]) : m;
+
+  if (m > 0.0)
+    for (size_t i = 0; i < p.size(); i++)
+      p[i] /= m;
+}
+
+coef_t MulCoef(const coef_t& a, const coef_t& b)
+{
+  if (a.empty() || b.empty())
+    return coef_t();
+
+  coef_t c(a.size() + b.size() - 1);
+  PolyMul(&a[0], a.size(), &b[0], b.size(), &c[0]);
+  return c;
+}
+
+// a ± b. Leading coefficients that cancel out are trimmed relative to
+// the operands (eps × their largest coefficient): what is left of a
+// cancellation is rounding noise of that size, not of size 1
+coef_t AddCoef(const coef_t& a, const coef_t& b, const double sign,
+               const double eps)
+{
+  coef_t c(a.size() > b.size() ? a.size() : b.size(), 0.0);
+  double m = 0.0;
+  for (size_t i = 0; i < a.size(); i++)
+  {
+    c[i] += a[i];
+    m = fabs(a[i]) > m ? fabs(a[i]) : m;
+  }
+  for (size_t i = 0; i < b.size(); i++)
+  {
+    c[i] += sign * b[i];
+    m = fabs(b[i]) > m ? fabs(b[i]) : m;
+  }
+
+  TrimCoef(c, eps * m);
+  return c;
+}
+
+// -- Division --
+
+// Long division, O(deg(q) × deg(b))
+void DivModSchoolbook(const coef_t& a, const coef_t& b, coef_t& q, coef_t& r,
+                      const double eps)
+{
+  const int n = a.size(), m = b.size();
+
+  r = a;
+  q.assign(n - m + 1, 0.0);
+
+  for (int k = n - m; k >= 0; k--)
+  {
+    q[k] = r[m - 1 + k] / b[m - 1];
+    for (int j = 0; j < m; j++)
+      r[j + k] -= q[k] * b[j];
+  }
+
+  r.resize(m - 1);
+  TrimCoef(r, eps);
+}
+
+// g with f × g = 1 mod x^k (f[0] != 0), by Newton's iteration
+//
+//   g <- g × (2 - f × g)   mod x^(2 × current precision)
+//
+// which doubles the number of correct coefficients every step, so the
+// whole inverse costs a few multiplications of size k
+coef_t InverseSeries(const coef_t& f, const int k)
+{
+  assert(!f.empty() && f[0] != 0.0);
+
+  coef_t g(1, 1.0 / f[0]);
+
+  for (int len = 1; len < k; )
+  {
+    len = (2 * len < k) ? 2 * len : k;
+
+    coef_t fl(f.begin(), f.begin() + ((int)f.size() < len ? f.size() : len));
+    coef_t e = MulCoef(fl, g);
+    e.resize(len, 0.0);
+    for (int i = 0; i < len; i++)
+      e[i] = -e[i];
+    e[0] += 2.0;
+
+    g = MulCoef(g, e);
+    g.resize(len, 0.0);
+  }
+
+  return g;
+}
+
+// Division through the reversed polynomials: with rev(p)(x) = x^deg(p) p(1/x),
+//
+//   rev(q) = rev(a) × rev(b)^-1   mod x^(deg(a) - deg(b) + 1)
+//
+// so q costs one series inverse plus one product, and r = a - b q another
+void DivModNewton(const coef_t& a, const coef_t& b, coef_t& q, coef_t& r,
+                  const double eps)
+{
+  const int n = a.size(), m = b.size();
+  const int k = n - m + 1;  // length of q
+
+  coef_t ra(a.rbegin(), a.rbegin() + k);
+  coef_t rb(b.rbegin(), b.rend());
+
+  coef_t rq = MulCoef(ra, InverseSeries(rb, k));
+  rq.resize(k);
+  q.assign(rq.rbegin(), rq.rend());
+
+  // Only the m-1 low coefficients of a - b q survive
+  coef_t bq = MulCoef(b, q);
+  r.assign(m - 1, 0.0);
+  for (int i = 0; i < m - 1; i++)
+    r[i] = a[i] - bq[i];
+
+  TrimCoef(r, eps);
+}
+
+// a = b q + r with deg(r) < deg(b); b must be trimmed and non-zero
+void DivModCoef(const coef_t& a, const coef_t& b, coef_t& q, coef_t& r,
+                const double eps)
+{
+  assert(!b.empty());
+
+  if (a.size() < b.size())
+  {
+    q.clear();
+    r = a;
+    return;
+  }
+
+  const int k = a.size() - b.size() + 1;
+  if (k >= DivNewtonThreshold && (int)b.size() >= DivNewtonThreshold)
+    DivModNewton(a, b, q, r, eps);
+  else
+    DivModSchoolbook(a, b, q, r, eps);
+}
+
+// -- GCD --
+
+// Monic gcd of a and b, by Euclid's algorithm. Both operands are
+// normalized to max|coef| = 1 after every step, so 'eps' decides what
+// counts as zero relative to the size of the polynomials, and remainders
+// do not drift towards over or underflow. O(deg(a) × deg(b)).
+// There is no half-GCD: in doubles its products of quotient matrices
+// lose the cancellations the degrees depend on, and it reports common
+// factors that are not there
+void GcdCoef(coef_t a, coef_t b, coef_t& g, const double eps)
+{
+  NormalizeCoef(a);
+  NormalizeCoef(b);
+  TrimCoef(a, eps);
+  TrimCoef(b, eps);
+  if (a.size() < b.size())
+    a.swap(b);
+
+  while (!b.empty())
+  {
+    coef_t q, r;
+    DivModCoef(a, b, q, r, eps);
+    a.swap(b);
+    b.swap(r);
+    NormalizeCoef(b);
+    TrimCoef(b, eps);
+  }
+
+  g = a;
+  if (!g.empty())
+  {
+    const double lead = g.back();
+    for (size_t i = 0; i < g.size(); i++)
+      g[i] /= lead;
+  }
+}
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef POLYNOMIAL_MULTIPLY_H_
+#define POLYNOMIAL_MULTIPLY_H_
+
+#include <cassert>
+#include <complex>
+#include <math.h>  // fabs, cos, sin, acos, ilogb
+
+#include "vector_t.h"
+
+// Crossovers of PolyMul, in coefficients of the shorter operand. They
+// are variables so they can be tuned at run time (see bench_polynomial)
+int KaratsubaThreshold = 48;   // schoolbook below this
+int FftThreshold = 384;        // Karatsuba below this, FFT from here on
+
+// MulFFT splits its operands in bands of coefficients this many binary
+// orders of magnitude apart, into at most FFT_MAX_BANDS of them
+#ifndef FFT_BAND_BITS
+#define FFT_BAND_BITS 20
+#endif
+#define FFT_MAX_BANDS 3
+
+typedef std::complex<double> complex_t;
+
+// Plain complex product. std::complex's operator* also checks for
+// inf/NaN operands (a libgcc call per product), which the FFT never needs
+inline complex_t CMul(const complex_t& a, const complex_t& b)
+{
+  return complex_t(a.real() * b.real() - a.imag() * b.imag(),
+                   a.real() * b.imag() + a.imag() * b.real());
+}
+
+// out[0 .. na+nb-1) = a × b, the way it is done by hand: O(na × nb)
+void MulSchoolbook(const double* a, const int na, const double* b, const int nb,
+                   double* out)
+{
+  for (int k = 0; k < na + nb - 1; k++)
+    out[k] = 0.0;
+
+  for (int i = 0; i < na; i++)
+  {
+    const double ai = a[i];
+    for (int j = 0; j < nb; j++)
+      out[i + j] += ai * b[j];
+  }
+}
+
+// Karatsuba for two operands of the same size n, out gets 2n-1 values.
+// With a = a0 + a1 x^h and b = b0 + b1 x^h:
+//
+//   a b = z0 + (z1 - z0 - z2) x^h + z2 x^2h
+//   z0 = a0 b0,  z2 = a1 b1,  z1 = (a0 + a1)(b0 + b1)
+//
+// three half-size products instead of four: O(n^1.585).
+// 'scratch' needs about 4n doubles (see MulKaratsuba)
+void KaratsubaSquare(const double* a, const double* b, const int n,
+                     double* out, double* scratch)
+{
+  if (n <= KaratsubaThreshold)
+  {
+    MulSchoolbook(a, n, b, n, out);
+    return;
+  }
+
+  const int h = n / 2;    // size of a0, b0
+  const int hi = n - h;   // size of a1, b1 (hi >= h)
+
+  // z0 -> out[0, 2h-1), z2 -> out[2h, 2n-1); out[2h-1] is in neither
+  KaratsubaSquare(a, b, h, out, scratch);
+  KaratsubaSquare(a + h, b + h, hi, out + 2 * h, scratch);
+  out[2 * h - 1] = 0.0;
+
+  double* sa = scratch;              // a0 + a1
+  double* sb = scratch + hi;         // b0 + b1
+  double* z1 = scratch + 2 * hi;     // 2hi-1 values
+  double* rest = z1 + 2 * hi - 1;
+
+  for (int i = 0; i < hi; i++)
+  {
+    sa[i] = a[h + i] + (i < h ? a[i] : 0.0);
+    sb[i] = b[h + i] + (i < h ? b[i] : 0.0);
+  }
+
+  KaratsubaSquare(sa, sb, hi, z1, rest);
+
+  for (int i = 0; i < 2 * h - 1; i++)
+    z1[i] -= out[i];
+  for (int i = 0; i < 2 * hi - 1; i++)
+    z1[i] -= out[2 * h + i];
+
+  for (int i = 0; i < 2 * hi - 1; i++)
+    out[h + i] += z1[i];
+}
+
+// out[0 .. na+nb-1) = a × b with Karatsuba. The longer operand is cut
+// into pieces as long as the shorter one, each piece is a square
+// product, and the pieces are added at their offsets
+void MulKaratsuba(const double* a, const int na, const double* b, const int nb,
+                  double* out)
+{
+  if (na < nb)
+  {
+    MulKaratsuba(b, nb, a, na, out);
+    return;
+  }
+
+  for (int k = 0; k < na + nb - 1; k++)
+    out[k] = 0.0;
+
+  vector_t<double> piece(2 * nb - 1);
+  vector_t<double> scratch(4 * nb + 64);
+
+  for (int off = 0; off < na; off += nb)
+  {
+    const int len = (na - off < nb) ? na - off : nb;
+
+    if (len == nb)
+      KaratsubaSquare(a + off, b, nb, piece.data(), scratch.data());
+    else
+      MulKaratsuba(b, nb, a + off, len, piece.data());  // last, shorter piece
+
+    for (int k = 0; k < len + nb - 1; k++)
+      out[off + k] += piece[k];
+  }
+}
+
+// In-place iterative radix-2 FFT of size n (a power of 2).
+// roots[k] = e^(-2πik/n) for k < n/2; 'invert' uses their conjugates
+// (the 1/n scaling is left to the caller)
+void Fft(complex_t* z, const int n, const complex_t* roots, const bool invert)
+{
+  // Bit-reversal permutation
+  for (int i = 1, j = 0; i < n; i++)
+  {
+    int bit = n >> 1;
+    for ( ; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+
+    if (i < j)
+    {
+      complex_t aux = z[i];
+      z[i] = z[j];
+      z[j] = aux;
+    }
+  }
+
+  for (int len = 2; len <= n; len <<= 1)
+  {
+    const int step = n / len;
+    for (int i = 0; i < n; i += len)
+      for (int j = 0; j < len / 2; j++)
+      {
+        complex_t w = invert ? std::conj(roots[j * step]) : roots[j * step];
+        complex_t u = z[i + j];
+        complex_t v = CMul(z[i + j + len / 2], w);
+        z[i + j] = u + v;
+        z[i + j + len / 2] = u - v;
+      }
+  }
+}
+
+// out[0 .. na+nb-1) = a × b (or += with 'add') with one forward and one
+// inverse complex FFT.
+// Both real inputs share a transform (a in the real part, b in the
+// imaginary one) and are pulled apart with the conjugate symmetry:
+//
+//   A_k = (Z_k + conj(Z_{n-k})) / 2,   B_k = (Z_k - conj(Z_{n-k})) / 2i
+//
+// The rounding error grows like eps × log(n) × max|a| × max|b| × n, so
+// b is first scaled to the magnitude of a: otherwise the smaller operand
+// would be drowned in the other's rounding inside Z. Every twiddle is
+// computed directly with cos/sin instead of by repeated multiplication,
+// which would add O(n) error of its own.
+void MulFFTCore(const double* a, const int na, const double* b, const int nb,
+                double* out, const bool add)
+{
+  const int size = na + nb - 1;
+  int n = 1;
+  while (n < size)
+    n <<= 1;
+
+  double max_a = 0.0, max_b = 0.0;
+  for (int i = 0; i < na; i++)
+    max_a = fabs(a[i]) > max_a ? fabs(a[i]) : max_a;
+  for (int i = 0; i < nb; i++)
+    max_b = fabs(b[i]) > max_b ? fabs(b[i]) : max_b;
+
+  if (max_a == 0.0 || max_b == 0.0)
+  {
+    for (int k = 0; k < size && !add; k++)
+      out[k] = 0.0;
+    return;
+  }
+
+  const double scale = max_a / max_b;
+  const double pi = acos(-1.0);
+
+  vector_t<complex_t> roots(n / 2 > 0 ? n / 2 : 1), z(n), p(n);
+  for (int k = 0; k < n / 2; k++)
+    roots[k] = complex_t(cos(2 * pi * k / n), -sin(2 * pi * k / n));
+
+  for (int k = 0; k < n; k++)
+    z[k] = complex_t(k < na ? a[k] : 0.0, k < nb ? b[k] * scale : 0.0);
+
+  Fft(z.data(), n, roots.data(), false);
+
+  for (int k = 0; k < n; k++)
+  {
+    complex_t zk = z[k];
+    complex_t zj = std::conj(z[(n - k) & (n - 1)]);
+    complex_t ak = (zk + zj) * 0.5;
+    complex_t bk = (zk - zj) * complex_t(0.0, -0.5);
+    p[k] = CMul(ak, bk);
+  }
+
+  Fft(p.data(), n, roots.data(), true);
+
+  for (int k = 0; k < size; k++)
+    out[k] = (add ? out[k] : 0.0) + p[k].real() / n / scale;
+}
+
+// Band of a coefficient of an operand whose largest is 'top': how many
+// FFT_BAND_BITS below it, the last band taking everything smaller
+inline int FftBand(const double x, const double top)
+{
+  const int band = (ilogb(top) - ilogb(x)) / FFT_BAND_BITS;
+  return (band < FFT_MAX_BANDS - 1) ? band : FFT_MAX_BANDS - 1;
+}
+
+// Band k of x goes to p[k × n, (k + 1) × n), the rest of it zero;
+// [lo[k], hi[k]) are the positions it has values in (empty if lo >= hi)
+void SplitBands(const double* x, const int n, const double top, const int bands,
+                double* p, int* lo, int* hi)
+{
+  for (int k = 0; k < bands * n; k++)
+    p[k] = 0.0;
+  for (int k = 0; k < bands; k++)
+  {
+    lo[k] = n;
+    hi[k] = 0;
+  }
+
+  for (int i = 0; i < n; i++)
+    if (x[i] != 0.0)
+    {
+      const int k = FftBand(x[i], top);
+      p[k * n + i] = x[i];
+      lo[k] = (i < lo[k]) ? i : lo[k];
+      hi[k] = i + 1;
+    }
+}
+
+// out[0 .. na+nb-1) = a × b by FFT, with the error bounded per band.
+// A single transform makes an absolute error of about eps × log(n) ×
+// max|a| × max|b| on every output, which wipes out the product
+// coefficients that only involve much smaller inputs. So each operand is
+// split by magnitude into bands FFT_BAND_BITS wide, and every pair of
+// bands is multiplied on its own, over the range of positions the two
+// have values in: the error of a pair is relative to the largest
+// coefficients of those two bands, and only lands on that range.
+// Operands without small coefficients are one band, a single transform.
+// The limits: at most FFT_MAX_BANDS bands (up to that squared
+// transforms), the last one taking all the smaller values, and bands
+// whose ranges interleave still share their errors.
+void MulFFT(const double* a, const int na, const double* b, const int nb,
+            double* out)
+{
+  double max_a = 0.0, max_b = 0.0;
+  for (int i = 0; i < na; i++)
+    max_a = fabs(a[i]) > max_a ? fabs(a[i]) : max_a;
+  for (int i = 0; i < nb; i++)
+    max_b = fabs(b[i]) > max_b ? fabs(b[i]) : max_b;
+
+  int bands_a = 1, bands_b = 1;
+  for (int i = 0; i < na; i++)
+    if (a[i] != 0.0 && FftBand(a[i], max_a) + 1 > bands_a)
+      bands_a = FftBand(a[i], max_a) + 1;
+  for (int i = 0; i < nb; i++)
+    if (b[i] != 0.0 && FftBand(b[i], max_b) + 1 > bands_b)
+      bands_b = FftBand(b[i], max_b) + 1;
+
+  if (bands_a == 1 && bands_b == 1)
+  {
+    MulFFTCore(a, na, b, nb, out, false);
+    return;
+  }
+
+  // Every band as an operand of its own, zero elsewhere, and the range
+  // of positions it has values in: a pair's product (and its rounding)
+  // only lands on the sum of their ranges
+  vector_t<double> pa(bands_a * na), pb(bands_b * nb);
+  int lo_a[FFT_MAX_BANDS], hi_a[FFT_MAX_BANDS], lo_b[FFT_MAX_BANDS], hi_b[FFT_MAX_BANDS];
+  SplitBands(a, na, max_a, bands_a, pa.data(), lo_a, hi_a);
+  SplitBands(b, nb, max_b, bands_b, pb.data(), lo_b, hi_b);
+
+  for (int k = 0; k < na + nb - 1; k++)
+    out[k] = 0.0;
+
+  // Smallest pairs first, so they are not added to large partial sums
+  for (int i = bands_a - 1; i >= 0; i--)
+    for (int j = bands_b - 1; j >= 0; j--)
+      if (lo_a[i] < hi_a[i] && lo_b[j] < hi_b[j])
+        MulFFTCore(pa.data() + i * na + lo_a[i], hi_a[i] - lo_a[i],
+                   pb.data() + j * nb + lo_b[j], hi_b[j] - lo_b[j],
+                   out + lo_a[i] + lo_b[j], true);
+}
+
+// out[0 .. na+nb-1) = a × b, picking the algorithm by the size of the
+// shorter operand. 'out' must not overlap a or b
+void PolyMul(const double* a, const int na, const double* b, const int nb,
+             double* out)
+{
+  assert(na > 0 && nb > 0);
+
+  const int n = (na < nb) ? na : nb;
+
+  if (n < KaratsubaThreshold)
+    MulSchoolbook(a, na, b, nb, out);
+  else if (n < FftThreshold)
+    MulKaratsuba(a, na, b, nb, out);
+  else
+    MulFFT(a, na, b, nb, out);
+}
+
+#endif
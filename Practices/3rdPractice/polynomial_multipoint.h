@@ -0,0 +1,268 @@
+#ifndef POLYNOMIAL_MULTIPOINT_H_
+#define POLYNOMIAL_MULTIPOINT_H_
+
+#include <cassert>
+#include <vector>
+#include <math.h>  // fabs, cos, acos
+
+#include "polynomial.h"
+#include "polynomial_division.h"
+
+// The affine change of variable, Chebyshev sampling and small exact
+// interpolation for the monomial Polynomial.
+//
+// No O(n log² n) multipoint evaluation is provided. The subproduct tree
+// that gives it (remainders of p by products of (x - x_i), down a binary
+// tree over the points) works in the monomial basis, where the remainders
+// lose their digits as soon as the tree has more than one level: at 64
+// points only 4 digits were left, at 1024 the results were NaN, and a
+// one-level tree is slower than Horner. MultipointEval is EvalMany.
+// Sampling a polynomial fast is EvalChebyshevPoints, which does not lose
+// accuracy with n.
+
+// Coefficients handled directly by ComposeAffine and ChebyshevLift; above
+// this they split the polynomial in halves
+#ifndef MULTIPOINT_LEAF
+#define MULTIPOINT_LEAF 32
+#endif
+
+// Most points Interpolate takes. Measured at Chebyshev points, the
+// relative error of the coefficients is ~4e-14 at 12 points on [-1, 1]
+// and ~1e-5 at 32, but the points' distance from 0 costs much more: on
+// [2, 4] it is ~1e-7 at 8 points, ~1e-2 at 12 and O(1) at 16
+#define INTERPOLATE_MAX 12
+
+// -- Affine change of variable --
+
+// q(t) = p(c + h t). Halves are composed recursively and joined with
+// the powers (c + h t)^(2^k), so this is O(M(n) log n) too
+coef_t ComposeAffine(const coef_t& p, const int first, const int len,
+                     const std::vector<coef_t>& pw)
+{
+  if (len <= MULTIPOINT_LEAF)
+  {
+    // Horner on polynomials: q <- q × (c + h t) + p_i
+    const double c = pw[0][0], h = pw[0][1];
+    coef_t q(len, 0.0);
+    for (int i = first + len - 1, deg = 0; i >= first; i--, deg++)
+    {
+      for (int k = deg; k > 0; k--)
+        q[k] = q[k] * c + q[k - 1] * h;
+      q[0] = q[0] * c + p[i];
+    }
+    return q;
+  }
+
+  int half = 1, k = 0;
+  for ( ; 2 * half < len; half *= 2)
+    k++;
+
+  coef_t lo = ComposeAffine(p, first, half, pw);
+  coef_t hi = ComposeAffine(p, first + half, len - half, pw);
+
+  return AddCoef(lo, MulCoef(hi, pw[k]), 1.0, 0.0);
+}
+
+coef_t ComposeAffine(const coef_t& p, const double c, const double h)
+{
+  if (p.empty())
+    return p;
+
+  std::vector<coef_t> pw(1, coef_t(2));  // pw[k] = (c + h t)^(2^k)
+  pw[0][0] = c;
+  pw[0][1] = h;
+  while ((size_t)(1 << pw.size()) < p.size())
+    pw.push_back(MulCoef(pw.back(), pw.back()));
+
+  return ComposeAffine(p, 0, p.size(), pw);
+}
+
+// n Chebyshev points of [a, b]: the roots of T_n, mapped to [a, b].
+// They cluster towards the ends, which is what keeps interpolation
+// through them well conditioned (equispaced points are the worst case)
+void ChebyshevPoints(const int n, const double a, const double b, double* xs)
+{
+  const double pi = acos(-1.0);
+
+  for (int i = 0; i < n; i++)
+    xs[i] = (a + b) / 2 + (b - a) / 2 * cos(pi * (2 * i + 1) / (2 * n));
+}
+
+// Σ q_k u^k z^(len-1-k) over q[first, first+len), with u = (1 + z²) / 2.
+// On the unit circle u / z = (z + 1/z) / 2 = cos θ, so this is q(cos θ)
+// times a power of z, as an ordinary polynomial in z. Built like
+// ComposeAffine: S = S_lo z^len(hi) + u^len(lo) S_hi, upw[k] = u^(2^k).
+// The coefficients of every u^k are binomials over 2^k, all in [0, 1],
+// so nothing here grows beyond Σ|q_k|
+coef_t ChebyshevLift(const coef_t& q, const int first, const int len,
+                     const std::vector<coef_t>& upw)
+{
+  if (len <= MULTIPOINT_LEAF)
+  {
+    coef_t s(2 * len - 1, 0.0);
+    s[0] = q[first + len - 1];
+
+    for (int k = len - 2, deg = 0; k >= 0; k--, deg += 2)
+    {
+      // s <- s × u + q_k z^(len-1-k)
+      for (int j = deg + 2; j >= 0; j--)
+        s[j] = ((j >= 2 ? s[j - 2] : 0.0) + (j <= deg ? s[j] : 0.0)) / 2;
+      s[len - 1 - k] += q[first + k];
+    }
+    return s;
+  }
+
+  int half = 1, k = 0;
+  for ( ; 2 * half < len; half *= 2)
+    k++;
+
+  coef_t lo = ChebyshevLift(q, first, half, upw);
+  coef_t hi = MulCoef(ChebyshevLift(q, first + half, len - half, upw), upw[k]);
+
+  for (size_t j = 0; j < lo.size(); j++)
+    hi[j + len - half] += lo[j];
+  return hi;
+}
+
+// out[i] = pol(xs[i]) at the n Chebyshev points of [a, b] (as given by
+// ChebyshevPoints), n a power of 2. This is the safe way to sample a
+// polynomial fast: with x = cos θ and z = e^(iθ), pol becomes a
+// polynomial in z (see ChebyshevLift) whose values at the points are
+// one FFT, and every step is as well conditioned as pol itself on
+// [a, b]. No subproduct tree, so no loss of accuracy with n.
+void EvalChebyshevPoints(const Polynomial& pol, const double a, const double b,
+                         const int n, double* out)
+{
+  assert(n > 0 && (n & (n - 1)) == 0);
+
+  coef_t p(pol.data(), pol.data() + pol.get_size());
+  coef_t q = ComposeAffine(p, (a + b) / 2, (b - a) / 2);
+  if (q.empty())
+  {
+    for (int i = 0; i < n; i++)
+      out[i] = 0.0;
+    return;
+  }
+
+  const int m = q.size();
+  std::vector<coef_t> upw(1, coef_t(3));  // upw[k] = u^(2^k)
+  upw[0][0] = upw[0][2] = 0.5;
+  while ((1 << upw.size()) < m)
+    upw.push_back(MulCoef(upw.back(), upw.back()));
+
+  coef_t r = ChebyshevLift(q, 0, m, upw);
+
+  // θ_i = π (2i + 1) / 2n, so z_i = ζ ω^i with ζ = e^(iπ/2n), ω a 2n-th
+  // root of unity. r(ζ ω^i) is a transform of size N = 2n of r_k ζ^k,
+  // with the coefficients past N folded back (ω^N = 1)
+  const int nn = 2 * n;
+  const double pi = acos(-1.0);
+
+  std::vector<complex_t> z(nn), roots(n);
+  for (size_t k = 0; k < r.size(); k++)
+    z[k % nn] += r[k] * complex_t(cos(pi * k / nn), sin(pi * k / nn));
+  for (int k = 0; k < n; k++)
+    roots[k] = complex_t(cos(2 * pi * k / nn), -sin(2 * pi * k / nn));
+
+  Fft(&z[0], nn, &roots[0], true);  // conjugate roots: Σ z_k ω^(ik)
+
+  // pol(x_i) = z_i^-(m-1) r(z_i), real up to rounding
+  for (int i = 0; i < n; i++)
+  {
+    const double t = -(m - 1) * pi * (2 * i + 1) / nn;
+    out[i] = z[i].real() * cos(t) - z[i].imag() * sin(t);
+  }
+}
+
+// -- Polynomial interface --
+
+// Center and half-width of the points' range, for mapping them to [-1, 1]
+void PointRange(const double* xs, const int n, double& c, double& h)
+{
+  double lo = xs[0], hi = xs[0];
+  for (int i = 1; i < n; i++)
+  {
+    lo = xs[i] < lo ? xs[i] : lo;
+    hi = xs[i] > hi ? xs[i] : hi;
+  }
+
+  c = (lo + hi) / 2;
+  h = (hi > lo) ? (hi - lo) / 2 : 1.0;
+}
+
+// out[i] = pol(xs[i]) for n points: EvalMany, O(deg × n) with full
+// accuracy (see the top of the file for why there is no tree here)
+void MultipointEval(const Polynomial& pol, const double* xs, double* out,
+                    const int n)
+{
+  pol.EvalMany(xs, out, n);
+}
+
+// The polynomial of degree < n through (xs[i], ys[i]), the points all
+// different. They are first mapped to [-1, 1], and there
+//
+//   q = Σ w_i M / (t - t_i),  M = Π (t - t_j),  w_i = ys[i] / Π_j≠i (t_i - t_j)
+//
+// with the quotients by synthetic division. Monomial coefficients of an
+// interpolant are ill-conditioned however they are computed, the more
+// so the further the points are from 0 (see INTERPOLATE_MAX). So this
+// only takes up to INTERPOLATE_MAX points and returns false,
+// leaving pol as it was, for more. A larger fit needs another basis:
+// sample at ChebyshevPoints and build a ChebyshevPolynomial
+bool Interpolate(const double* xs, const double* ys, const int n, Polynomial& pol)
+{
+  if (n > INTERPOLATE_MAX)
+    return false;
+
+  if (n == 0)
+  {
+    pol.resize(0);
+    return true;
+  }
+
+  double c, h;
+  PointRange(xs, n, c, h);
+
+  std::vector<double> ts(n);
+  for (int i = 0; i < n; i++)
+    ts[i] = (xs[i] - c) / h;
+
+  // m <- m × (t - t_i)
+  coef_t m(1, 1.0);
+  for (int i = 0; i < n; i++)
+  {
+    m.push_back(0.0);
+    for (int j = m.size() - 1; j > 0; j--)
+      m[j] = m[j - 1] - ts[i] * m[j];
+    m[0] *= -ts[i];
+  }
+
+  coef_t q(n, 0.0);
+  for (int i = 0; i < n; i++)
+  {
+    double d = 1.0;
+    for (int j = 0; j < n; j++)
+      if (j != i)
+        d *= ts[i] - ts[j];
+
+    const double w = ys[i] / d;
+    double b = 0.0;
+    for (int j = n; j > 0; j--)
+    {
+      b = m[j] + b * ts[i];  // coefficient j-1 of M / (t - t_i)
+      q[j - 1] += w * b;
+    }
+  }
+
+  coef_t p = ComposeAffine(q, -c / h, 1.0 / h);  // t = (x - c) / h
+  p.resize(n, 0.0);
+
+  if (pol.get_size() != n)
+    pol.resize(n);
+  for (int i = 0; i < n; i++)
+    pol[i] = p[i];
+
+  return true;
+}
+
+#endif
@@ -0,0 +1,225 @@
+#ifndef POLYNOMIAL_ROOTS_H_
+#define POLYNOMIAL_ROOTS_H_
+
+#include <cassert>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <cmath>   // std::isfinite
+#include <math.h>  // fabs, pow, cos, sin, acos
+
+#include "polynomial.h"
+
+// Sweeps over all the roots before giving up
+#ifndef ABERTH_MAX_ITER
+#define ABERTH_MAX_ITER 100
+#endif
+
+// Polynomials a worker takes from the batch at a time
+#define ROOTS_CHUNK 16
+
+// a / b without std::complex's inf/NaN handling (see CMul)
+inline complex_t CDiv(const complex_t& a, const complex_t& b)
+{
+  const double d = b.real() * b.real() + b.imag() * b.imag();
+  return complex_t((a.real() * b.real() + a.imag() * b.imag()) / d,
+                   (a.imag() * b.real() - a.real() * b.imag()) / d);
+}
+
+// Newton correction p(z) / p'(z) of the polynomial a[0 .. n], both by
+// Horner. Outside the unit circle the powers of z would swamp the low
+// coefficients, so there it uses the reversed polynomial at w = 1/z:
+//
+//   p'(z) / p(z) = w (n - w rev'(w) / rev(w))
+//
+// 'small' is set when |p(z)| is down to the rounding error of its own
+// evaluation (u × Σ|a_k||z|^k, times a safety factor): z is then a root
+// as far as doubles can tell.
+complex_t NewtonCorrection(const double* a, const int n, const complex_t& z,
+                           bool& small)
+{
+  const double eps_mach = 2.2e-16;
+  const double r = std::abs(z);
+
+  complex_t p, dp;
+  double bound = 0.0;
+
+  if (r <= 1.0)
+  {
+    p = a[n];
+    dp = 0.0;
+    bound = fabs(a[n]);
+    for (int k = n - 1; k >= 0; k--)
+    {
+      dp = CMul(dp, z) + p;
+      p = CMul(p, z) + a[k];
+      bound = bound * r + fabs(a[k]);
+    }
+
+    small = std::abs(p) <= 4 * n * eps_mach * bound;
+    return small ? complex_t(0.0, 0.0) : CDiv(p, dp);
+  }
+
+  const complex_t w = CDiv(1.0, z);
+  const double rw = 1.0 / r;
+
+  p = a[0];
+  dp = 0.0;
+  bound = fabs(a[0]);
+  for (int k = 1; k <= n; k++)
+  {
+    dp = CMul(dp, w) + p;
+    p = CMul(p, w) + a[k];
+    bound = bound * rw + fabs(a[k]);
+  }
+
+  small = std::abs(p) <= 4 * n * eps_mach * bound;
+  if (small)
+    return complex_t(0.0, 0.0);
+
+  // p'(z) / p(z) from rev(w) = p and rev'(w) = dp
+  complex_t ratio = CMul(w, (double)n - CMul(w, CDiv(dp, p)));
+  return CDiv(1.0, ratio);
+}
+
+// All the roots of a[0 .. n] (a[n] != 0, a[0] != 0) by the Aberth–Ehrlich
+// iteration. Every root is moved by its Newton step corrected for the
+// other approximations, as if they were already the other roots:
+//
+//   z_i <- z_i - N_i / (1 - N_i Σ_{j != i} 1 / (z_i - z_j)),  N_i = p / p'
+//
+// which converges cubically to simple roots and, unlike Newton alone,
+// keeps the approximations from piling up on the same root. Updated z_j
+// are used as soon as they are ready (Gauss–Seidel style), and roots
+// that have converged stop moving. Starting points are spread on the
+// circle of radius |a0/an|^(1/n), the geometric mean of the roots'
+// moduli. Returns the sweeps done, or -1 if some root did not converge.
+int AberthRoots(const double* a, const int n, complex_t* z)
+{
+  const double pi = acos(-1.0);
+  const double radius = pow(fabs(a[0] / a[n]), 1.0 / n);
+
+  // Angle offset so no point starts on the real axis (real coefficients
+  // give a symmetric iteration that could never leave it)
+  for (int i = 0; i < n; i++)
+  {
+    const double t = 2 * pi * i / n + 0.4;
+    z[i] = complex_t(radius * cos(t), radius * sin(t));
+  }
+
+  std::vector<char> done(n, 0);
+  int left = n;
+
+  for (int iter = 1; iter <= ABERTH_MAX_ITER; iter++)
+  {
+    for (int i = 0; i < n; i++)
+    {
+      if (done[i])
+        continue;
+
+      bool small;
+      complex_t newton = NewtonCorrection(a, n, z[i], small);
+      if (small)
+      {
+        done[i] = 1;
+        left--;
+        continue;
+      }
+
+      complex_t sum = 0.0;
+      for (int j = 0; j < n; j++)
+        if (j != i)
+          sum += CDiv(1.0, z[i] - z[j]);
+
+      complex_t step = CDiv(newton, 1.0 - CMul(newton, sum));
+      if (!std::isfinite(step.real()) || !std::isfinite(step.imag()))
+      {
+        // On a critical point (p' = 0) or on top of another root: nudge it
+        z[i] *= complex_t(1.0, 1.0e-3);
+        continue;
+      }
+      z[i] -= step;
+
+      if (std::abs(step) <= 4 * 2.2e-16 * std::abs(z[i]))
+      {
+        done[i] = 1;
+        left--;
+      }
+    }
+
+    if (left == 0)
+      return iter;
+  }
+
+  return -1;
+}
+
+// Roots of a polynomial, with multiplicity: as many as its degree, where
+// leading coefficients that are not IsNotZero(·, eps) do not count.
+// Zero roots are taken out exactly first. Returns the sweeps of the
+// iteration, or -1 if it did not converge (the roots are then the last
+// approximations)
+int FindRoots(const Polynomial& pol, std::vector<complex_t>& roots,
+              const double eps = EPS)
+{
+  int n = pol.get_size() - 1;
+  while (n >= 0 && !IsNotZero(pol[n], eps))
+    n--;
+
+  int low = 0;  // exact zero roots
+  while (low < n && pol[low] == 0.0)
+    low++;
+
+  roots.assign(n > 0 ? n : 0, complex_t(0.0, 0.0));
+  if (n - low <= 0)
+    return 0;
+
+  return AberthRoots(pol.data() + low, n - low, roots.data() + low);
+}
+
+// Worker of the batch: takes ROOTS_CHUNK polynomials at a time from
+// 'next' until there are none left
+void FindRootsWorker(const Polynomial* pols, const int count,
+                     std::vector<complex_t>* roots, std::atomic<int>* next,
+                     std::atomic<int>* failed, const double eps)
+{
+  for (int first = (*next)++ * ROOTS_CHUNK; first < count;
+       first = (*next)++ * ROOTS_CHUNK)
+  {
+    const int last = (first + ROOTS_CHUNK < count) ? first + ROOTS_CHUNK : count;
+    for (int k = first; k < last; k++)
+      if (FindRoots(pols[k], roots[k], eps) < 0)
+        (*failed)++;
+  }
+}
+
+// Roots of count polynomials, roots[k] for pols[k], on nthreads threads
+// (this one included). Polynomials are handed out in small chunks from a
+// shared counter, so threads that get the easy ones just take more. Each
+// polynomial is always solved the same way by one thread, so the results
+// do not depend on the number of threads or on the scheduling.
+// Returns how many did not converge.
+int FindRoots(const Polynomial* pols, const int count,
+              std::vector<complex_t>* roots, const int nthreads,
+              const double eps = EPS)
+{
+  int t = nthreads;
+  if (t > (count + ROOTS_CHUNK - 1) / ROOTS_CHUNK)
+    t = (count + ROOTS_CHUNK - 1) / ROOTS_CHUNK;
+  if (t < 1)
+    t = 1;
+
+  std::atomic<int> next(0), failed(0);
+
+  std::vector<std::thread> workers;
+  for (int k = 1; k < t; k++)
+    workers.push_back(std::thread(FindRootsWorker, pols, count, roots,
+                                  &next, &failed, eps));
+  FindRootsWorker(pols, count, roots, &next, &failed, eps);
+  for (size_t k = 0; k < workers.size(); k++)
+    workers[k].join();
+
+  return failed;
+}
+
+#endif
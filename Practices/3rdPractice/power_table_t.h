@@ -0,0 +1,147 @@
+#ifndef POWER_TABLET_H_
+#define POWER_TABLET_H_
+
+#include <cassert>
+#include <math.h>  // pow
+#include <limits.h>  // INT_MAX
+
+// Exponents are 'int', so 31 squarings cover all of them
+#define POWER_TABLE_SIZE 31
+
+// Most terms a running power goes from the power it was last computed
+// from scratch, and most exponents when the gaps are done by squaring
+// (see power_anchor_t)
+#define POWER_REANCHOR 32
+
+// x^e for e >= 0 by repeated squaring: about 2 × log2(e) multiplies
+// instead of a libm call. Every squaring doubles the relative error of
+// the one before, so the result is only within about e ulps
+inline double IntPow(double x, int e)
+{
+  assert(e >= 0);
+
+  double result = 1.0;
+  while (e > 0)
+  {
+    if (e & 1)
+      result *= x;
+    x *= x;
+    e >>= 1;
+  }
+
+  return result;
+}
+
+// Table of x^(2^k) for a fixed x. Built once, it turns every x^e into
+// one multiply per set bit of e, and can be shared by all the
+// polynomials evaluated at that same x. The entries are taken from
+// pow(), not squared from each other, so each is within an ulp and x^e
+// within about 2 ulps per set bit of e, however large e is
+class power_table_t {
+ public:
+  // -- Constructors --
+
+  power_table_t(const double, const int = (1 << 30));  // x, largest exponent
+
+  // -- Getters --
+
+  double get_x(void) const { return sq_[0]; }
+  double pow(int) const;
+
+ private:
+  double sq_[POWER_TABLE_SIZE];  // sq_[k] = x^(2^k)
+  int levels_;                   // entries of sq_ that were filled
+};
+
+// Only the squares the largest exponent can need are computed
+power_table_t::power_table_t(const double x, const int max_exp)
+    : levels_(1)
+{
+  sq_[0] = x;
+  while (levels_ < POWER_TABLE_SIZE && (max_exp >> levels_) > 0)
+  {
+    sq_[levels_] = ::pow(x, (double)(1 << levels_));
+    levels_++;
+  }
+}
+
+inline double power_table_t::pow(int e) const
+{
+  assert(e >= 0 && (e >> levels_) == 0);
+
+  double result = 1.0;
+  for (int k = 0; e > 0; k++, e >>= 1)
+    if (e & 1)
+      result *= sq_[k];
+
+  return result;
+}
+
+// Bookkeeping of the running power of the sparse Evals. With ascending
+// exponents x^e = x^prev × x^(e - prev), so the power can be carried from
+// term to term with no pow() per term. But every step adds its rounding,
+// and squaring to x^gap (IntPow) about gap ulps more. So the power is
+// taken from scratch again, with AnchorPow, once it has moved
+// POWER_REANCHOR terms or 'span' exponents from the last time: it stays
+// within about 2 × POWER_REANCHOR ulps of the anchor (a table adds
+// about 2 per set bit of each gap), and pow() gets that within an ulp.
+// The span is POWER_REANCHOR for IntPow, and unlimited for a table,
+// whose x^gap loses no more with a wide gap than a narrow one (PowerSpan
+// gives both).
+//
+// That is close to pow() per term, but not better. Terms more than
+// POWER_REANCHOR apart get a pow() each, so with only a double x a very
+// sparse polynomial is no faster than a pow() loop; the power_table_t
+// overloads keep those fast too.
+//
+//   power_anchor_t anchor(PowerSpan(x));
+//   power = anchor.step(e) ? AnchorPow(x, e) : power * GapPow(x, anchor.get_gap());
+class power_anchor_t {
+ public:
+  // -- Constructors --
+
+  power_anchor_t(const int span)
+      : prev_(0), gap_(0), from_(0), steps_(POWER_REANCHOR), span_(span) {}
+
+  // -- Getters --
+
+  int get_gap(void) const { return gap_; }  // e - prev of the last step
+
+  // -- Operations --
+
+  bool step(const int);  // on to exponent e: true if x^e goes from scratch
+
+ private:
+  int prev_;   // last exponent
+  int gap_;
+  int from_;   // exponent of the last anchor
+  int steps_;  // terms since then
+  int span_;   // most exponents from it
+};
+
+inline bool power_anchor_t::step(const int e)
+{
+  gap_ = e - prev_;
+  prev_ = e;
+
+  if (gap_ < 0 || steps_ >= POWER_REANCHOR || e - from_ > span_)
+  {
+    from_ = e;
+    steps_ = 1;
+    return true;
+  }
+
+  steps_++;
+  return false;
+}
+
+// x^e from scratch (AnchorPow) or for a short gap (GapPow), from x
+// itself or from its table
+inline double AnchorPow(const double x, const int e) { return pow(x, e); }
+inline double AnchorPow(const power_table_t& pt, const int e) { return pt.pow(e); }
+inline double GapPow(const double x, const int e) { return IntPow(x, e); }
+inline double GapPow(const power_table_t& pt, const int e) { return pt.pow(e); }
+inline int PowerSpan(const double) { return POWER_REANCHOR; }
+inline int PowerSpan(const power_table_t&) { return INT_MAX; }
+
+#endif
@@ -0,0 +1,608 @@
+#ifndef SPARSE_MATRIXT_H_
+#define SPARSE_MATRIXT_H_
+
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include <functional>  // std::cref
+#include <algorithm>   // std::sort
+
+#include "vector_t.h"
+#include "sparse_vector_t.h"
+
+// Fewer non-zeros than this per thread are not worth spawning threads for
+#ifndef SPMV_MIN_NNZ_PER_THREAD
+#define SPMV_MIN_NNZ_PER_THREAD 50000
+#endif
+
+// Same for the multiply-adds of a sparse matrix-matrix product
+#ifndef SPGEMM_MIN_FLOPS_PER_THREAD
+#define SPGEMM_MIN_FLOPS_PER_THREAD 100000
+#endif
+
+// Compressed Sparse Row matrix. Same idea as sparse_vector_t, but with
+// all the rows glued together and an array telling where each one starts:
+//
+//   | 5 0 0 |       row_ptr -> [0,    1,       3,    4]
+//   | 0 2 7 |   ->  col     -> [0,    1,  2,   1   ]
+//   | 0 3 0 |       val     -> [5.0,  2.0, 7.0, 3.0 ]
+//
+// Row i lives in [row_ptr[i], row_ptr[i+1]), columns sorted ascending.
+class csr_matrix_t {
+ public:
+  // -- Constructors --
+
+  csr_matrix_t(const int = 0, const int = 0);
+  csr_matrix_t(const vector_t<sparse_vector_t>&);   // one sparse row each
+  csr_matrix_t(const int, const int,                // COO triples
+               const int*, const int*, const double*, const int,
+               const double = EPS);
+
+  // -- Destructor --
+
+  ~csr_matrix_t() {}
+
+  // -- Getters --
+
+  int get_m(void) const { return m_; }
+  int get_n(void) const { return n_; }
+  int get_nnz(void) const { return row_ptr_[m_]; }
+
+  const int* get_row_ptr(void) const { return row_ptr_.data(); }
+  const int* get_col(void) const { return col_.data(); }
+  const double* get_val(void) const { return val_.data(); }
+
+  double get_val(const int, const int) const;
+  sparse_vector_t get_row(const int) const;
+
+  // -- Operations --
+
+  void multiply(const double*, double*) const;             // y = A x
+  void multiply(const double*, double*, const int) const;  // threaded
+  void multiply(const csr_matrix_t&, const csr_matrix_t&,  // this = A B
+                const int = 1, const double = EPS);
+  csr_matrix_t transpose(void) const;
+
+  // -- I/O --
+
+  void write(std::ostream& = std::cout) const;
+
+ private:
+  int m_, n_;              // rows, columns
+  vector_t<int> row_ptr_;  // m_ + 1 offsets into col_/val_
+  vector_t<int> col_;      // column of each non-zero
+  vector_t<double> val_;   // value of each non-zero
+
+  void multiply_rows(const int, const int, const double*, double*) const;
+  void spgemm_rows(const csr_matrix_t&, const csr_matrix_t&,
+                   const int, const int, const long*, const bool);
+};
+
+// Compressed Sparse Column matrix: the CSR layout of the transpose
+class csc_matrix_t {
+ public:
+  // -- Constructors --
+
+  csc_matrix_t(const csr_matrix_t&);
+
+  // -- Destructor --
+
+  ~csc_matrix_t() {}
+
+  // -- Getters --
+
+  int get_m(void) const { return m_; }
+  int get_n(void) const { return n_; }
+  int get_nnz(void) const { return col_ptr_[n_]; }
+
+  const int* get_col_ptr(void) const { return col_ptr_.data(); }
+  const int* get_row(void) const { return row_.data(); }
+  const double* get_val(void) const { return val_.data(); }
+
+  sparse_vector_t get_col(const int) const;
+
+  // -- Operations --
+
+  void multiply(const double*, double*) const;  // y = A x
+
+ private:
+  int m_, n_;              // rows, columns
+  vector_t<int> col_ptr_;  // n_ + 1 offsets into row_/val_
+  vector_t<int> row_;      // row of each non-zero
+  vector_t<double> val_;   // value of each non-zero
+};
+
+// Counting-sort transposition of a compressed layout with 'm' major
+// entries (rows for CSR) and 'n' minor ones. The output comes sorted
+// by minor index, and inside each, by major index, in O(m + n + nnz)
+void CompressedTranspose(const int m, const int n,
+                         const int* ptr, const int* inx, const double* val,
+                         int* tptr, int* tinx, double* tval)
+{
+  for (int j = 0; j <= n; j++)
+    tptr[j] = 0;
+
+  for (int k = 0; k < ptr[m]; k++)
+    tptr[inx[k] + 1]++;
+
+  for (int j = 0; j < n; j++)
+    tptr[j + 1] += tptr[j];
+
+  // Scatter; tptr[j] is used as the insertion cursor of column j and
+  // ends up shifted one column to the left
+  for (int i = 0; i < m; i++)
+    for (int k = ptr[i]; k < ptr[i + 1]; k++)
+    {
+      int dst = tptr[inx[k]]++;
+      tinx[dst] = i;
+      tval[dst] = val[k];
+    }
+
+  for (int j = n; j > 0; j--)
+    tptr[j] = tptr[j - 1];
+  tptr[0] = 0;
+}
+
+// Splits rows [0, m) into t contiguous blocks of about the same weight,
+// given the prefix sums of the row weights (prefix[m] = total weight).
+// Block k is [bounds[k], bounds[k+1])
+template<class W>
+void SplitByWeight(const W* prefix, const int m, const int t, int* bounds)
+{
+  bounds[0] = 0;
+  bounds[t] = m;
+
+  for (int k = 1; k < t; k++)
+  {
+    // First row whose prefix reaches k/t of the total
+    W target = (W)((double)prefix[m] * k / t);
+    int lo = bounds[k - 1], hi = m;
+    while (lo < hi)
+    {
+      int mid = (lo + hi) / 2;
+      if (prefix[mid] < target)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    bounds[k] = lo;
+  }
+}
+
+// -- CSR --
+
+csr_matrix_t::csr_matrix_t(const int m, const int n)
+    : m_(m), n_(n), row_ptr_(m + 1)
+{
+  for (int i = 0; i <= m_; i++)
+    row_ptr_[i] = 0;
+}
+
+csr_matrix_t::csr_matrix_t(const vector_t<sparse_vector_t>& rows)
+    : m_(rows.get_size()), n_(0), row_ptr_(rows.get_size() + 1)
+{
+  row_ptr_[0] = 0;
+  for (int i = 0; i < m_; i++)
+  {
+    if (rows[i].get_n() > n_)
+      n_ = rows[i].get_n();
+    row_ptr_[i + 1] = row_ptr_[i] + rows[i].get_nz();
+  }
+
+  col_.resize(row_ptr_[m_]);
+  val_.resize(row_ptr_[m_]);
+
+  // The rows are already sorted and zero-free, just copy them in
+  for (int i = 0; i < m_; i++)
+    for (int k = 0; k < rows[i].get_nz(); k++)
+    {
+      col_[row_ptr_[i] + k] = rows[i][k].get_inx();
+      val_[row_ptr_[i] + k] = rows[i][k].get_val();
+    }
+}
+
+// COO triples in any order. Duplicate (i, j) entries are summed and
+// whatever ends up under eps is dropped
+csr_matrix_t::csr_matrix_t(const int m, const int n,
+                           const int* rows, const int* cols, const double* vals,
+                           const int nnz, const double eps)
+    : m_(m), n_(n), row_ptr_(m + 1)
+{
+  // 1st pass: bucket by column (that is, build the CSC form)
+  vector_t<int> col_ptr(n + 1), crow(nnz);
+  vector_t<double> cval(nnz);
+
+  for (int j = 0; j <= n; j++)
+    col_ptr[j] = 0;
+  for (int k = 0; k < nnz; k++)
+  {
+    assert(rows[k] >= 0 && rows[k] < m && cols[k] >= 0 && cols[k] < n);
+    col_ptr[cols[k] + 1]++;
+  }
+  for (int j = 0; j < n; j++)
+    col_ptr[j + 1] += col_ptr[j];
+
+  vector_t<int> cursor(n);
+  for (int j = 0; j < n; j++)
+    cursor[j] = col_ptr[j];
+  for (int k = 0; k < nnz; k++)
+  {
+    int dst = cursor[cols[k]]++;
+    crow[dst] = rows[k];
+    cval[dst] = vals[k];
+  }
+
+  // 2nd pass: transposing back leaves every row sorted by column
+  col_.resize(nnz);
+  val_.resize(nnz);
+  CompressedTranspose(n, m, col_ptr.data(), crow.data(), cval.data(),
+                      row_ptr_.data(), col_.data(), val_.data());
+
+  // Duplicates are now next to each other: merge them in place
+  int out = 0;
+  for (int i = 0; i < m_; i++)
+  {
+    int begin = row_ptr_[i], end = row_ptr_[i + 1];
+    row_ptr_[i] = out;
+
+    for (int k = begin; k < end; )
+    {
+      int j = col_[k];
+      double sum = 0.0;
+      for ( ; k < end && col_[k] == j; k++)
+        sum += val_[k];
+
+      if (IsNotZero(sum, eps))
+      {
+        col_[out] = j;
+        val_[out] = sum;
+        out++;
+      }
+    }
+  }
+  row_ptr_[m_] = out;
+}
+
+double csr_matrix_t::get_val(const int i, const int j) const
+{
+  assert(i >= 0 && i < m_ && j >= 0 && j < n_);
+
+  int lo = row_ptr_[i], hi = row_ptr_[i + 1] - 1;
+  while (lo <= hi)
+  {
+    int mid = (lo + hi) / 2;
+    if (col_[mid] == j)
+      return val_[mid];
+    if (col_[mid] < j)
+      lo = mid + 1;
+    else
+      hi = mid - 1;
+  }
+
+  return 0.0;
+}
+
+sparse_vector_t csr_matrix_t::get_row(const int i) const
+{
+  assert(i >= 0 && i < m_);
+
+  pair_vector_t pv(row_ptr_[i + 1] - row_ptr_[i]);
+  for (int k = row_ptr_[i]; k < row_ptr_[i + 1]; k++)
+    pv[k - row_ptr_[i]].set(val_[k], col_[k]);
+
+  return sparse_vector_t(pv, n_);
+}
+
+// y[first..last) = A[first..last) x, reading the arrays straight through
+void csr_matrix_t::multiply_rows(const int first, const int last,
+                                 const double* x, double* y) const
+{
+  const int* ptr = row_ptr_.data();
+  const int* col = col_.data();
+  const double* val = val_.data();
+
+  for (int i = first; i < last; i++)
+  {
+    double sum = 0.0;
+    for (int k = ptr[i]; k < ptr[i + 1]; k++)
+      sum += val[k] * x[col[k]];
+    y[i] = sum;
+  }
+}
+
+void csr_matrix_t::multiply(const double* x, double* y) const
+{
+  multiply_rows(0, m_, x, y);
+}
+
+// Every thread gets a contiguous block of rows holding about nnz/nthreads
+// non-zeros, so one dense row does not leave the other threads idle.
+// Threads write disjoint parts of y, no locking needed
+void csr_matrix_t::multiply(const double* x, double* y, const int nthreads) const
+{
+  int t = nthreads;
+  if (t > get_nnz() / SPMV_MIN_NNZ_PER_THREAD)
+    t = get_nnz() / SPMV_MIN_NNZ_PER_THREAD;
+
+  if (t <= 1)
+  {
+    multiply(x, y);
+    return;
+  }
+
+  vector_t<int> bounds(t + 1);
+  SplitByWeight(row_ptr_.data(), m_, t, bounds.data());
+
+  vector_t<std::thread> workers(t - 1);
+  for (int k = 1; k < t; k++)
+    workers[k - 1] = std::thread(&csr_matrix_t::multiply_rows, this,
+                                 bounds[k], bounds[k + 1], x, y);
+
+  multiply_rows(bounds[0], bounds[1], x, y);  // this thread takes block 0
+
+  for (int k = 0; k < t - 1; k++)
+    workers[k].join();
+}
+
+// One entry of a row of C while it is being sorted by column
+struct spgemm_entry_t {
+  int col;
+  double val;
+
+  bool operator<(const spgemm_entry_t& e) const { return col < e.col; }
+};
+
+// Rows [first, last) of C = A B. With 'symbolic' set it only counts the
+// distinct columns of each row into row_ptr_[i + 1]; otherwise it fills
+// col_/val_ from the final row_ptr_.
+//
+// Every row gets an open-addressing hash table (keys = columns of C) with
+// at least twice as many slots as the row has products, and only those
+// slots are cleared, so a row costs O(its flops) no matter how wide B is
+void csr_matrix_t::spgemm_rows(const csr_matrix_t& A, const csr_matrix_t& B,
+                               const int first, const int last,
+                               const long* flops, const bool symbolic)
+{
+  long max_flops = 0;
+  for (int i = first; i < last; i++)
+    if (flops[i + 1] - flops[i] > max_flops)
+      max_flops = flops[i + 1] - flops[i];
+
+  int cap = 1;
+  while (cap < 2 * max_flops)
+    cap *= 2;
+
+  vector_t<int> keys(cap);
+  vector_t<double> vals(symbolic ? 0 : cap);
+  vector_t<spgemm_entry_t> entries(symbolic ? 0 : cap);
+
+  int* key = keys.data();
+  double* acc = vals.data();
+  spgemm_entry_t* row = entries.data();
+
+  const int* a_ptr = A.row_ptr_.data();
+  const int* a_col = A.col_.data();
+  const double* a_val = A.val_.data();
+  const int* b_ptr = B.row_ptr_.data();
+  const int* b_col = B.col_.data();
+  const double* b_val = B.val_.data();
+
+  for (int i = first; i < last; i++)
+  {
+    long f = flops[i + 1] - flops[i];
+    int size = 1;
+    while (size < 2 * f)
+      size *= 2;
+    const unsigned mask = size - 1;
+
+    for (int h = 0; h < size; h++)
+      key[h] = -1;
+
+    int count = 0;
+    for (int ka = a_ptr[i]; ka < a_ptr[i + 1]; ka++)
+    {
+      int k = a_col[ka];
+      double aik = a_val[ka];
+
+      for (int kb = b_ptr[k]; kb < b_ptr[k + 1]; kb++)
+      {
+        int j = b_col[kb];
+        unsigned h = ((unsigned)j * 2654435761u) & mask;  // Knuth's hash
+
+        while (key[h] != -1 && key[h] != j)
+          h = (h + 1) & mask;
+
+        if (key[h] == -1)
+        {
+          key[h] = j;
+          count++;
+          if (!symbolic)
+            acc[h] = 0.0;
+        }
+
+        if (!symbolic)
+          acc[h] += aik * b_val[kb];
+      }
+    }
+
+    if (symbolic)
+    {
+      row_ptr_[i + 1] = count;
+      continue;
+    }
+
+    // Gather the occupied slots and write them sorted by column
+    int n = 0;
+    for (int h = 0; h < size; h++)
+      if (key[h] != -1)
+      {
+        row[n].col = key[h];
+        row[n].val = acc[h];
+        n++;
+      }
+
+    std::sort(row, row + n);
+
+    for (int e = 0; e < n; e++)
+    {
+      col_[row_ptr_[i] + e] = row[e].col;
+      val_[row_ptr_[i] + e] = row[e].val;
+    }
+  }
+}
+
+// C = A B for sparse A and B (the matrix_t::multiply counterpart).
+// Rows are split into blocks with about the same number of flops (the
+// a_ik * b_kj products each row needs) and every block goes to a thread:
+//
+//   1. symbolic: count the distinct columns of each row of C
+//   2. prefix sums give row_ptr_, col_/val_ are allocated once
+//   3. numeric: each thread accumulates and writes its rows in place
+//
+// Products that cancel under eps are squeezed out at the end.
+void csr_matrix_t::multiply(const csr_matrix_t& A, const csr_matrix_t& B,
+                            const int nthreads, const double eps)
+{
+  assert(A.get_n() == B.get_m());
+  assert(this != &A && this != &B);
+
+  m_ = A.get_m();
+  n_ = B.get_n();
+  row_ptr_.resize(m_ + 1);
+
+  vector_t<long> flops(m_ + 1);
+  flops[0] = 0;
+  for (int i = 0; i < m_; i++)
+  {
+    long f = 0;
+    for (int k = A.row_ptr_[i]; k < A.row_ptr_[i + 1]; k++)
+      f += B.row_ptr_[A.col_[k] + 1] - B.row_ptr_[A.col_[k]];
+    flops[i + 1] = flops[i] + f;
+  }
+
+  int t = nthreads;
+  if (t > flops[m_] / SPGEMM_MIN_FLOPS_PER_THREAD)
+    t = (int)(flops[m_] / SPGEMM_MIN_FLOPS_PER_THREAD);
+  if (t < 1)
+    t = 1;
+
+  vector_t<int> bounds(t + 1);
+  SplitByWeight(flops.data(), m_, t, bounds.data());
+
+  vector_t<std::thread> workers(t - 1);
+  for (int phase = 0; phase < 2; phase++)
+  {
+    const bool symbolic = (phase == 0);
+
+    if (!symbolic)
+    {
+      // Counts -> offsets, then room for exactly that many entries
+      row_ptr_[0] = 0;
+      for (int i = 0; i < m_; i++)
+        row_ptr_[i + 1] += row_ptr_[i];
+
+      col_.resize(row_ptr_[m_]);
+      val_.resize(row_ptr_[m_]);
+    }
+
+    for (int k = 1; k < t; k++)
+      workers[k - 1] = std::thread(&csr_matrix_t::spgemm_rows, this,
+                                   std::cref(A), std::cref(B),
+                                   bounds[k], bounds[k + 1], flops.data(),
+                                   symbolic);
+
+    spgemm_rows(A, B, bounds[0], bounds[1], flops.data(), symbolic);
+
+    for (int k = 0; k < t - 1; k++)
+      workers[k].join();
+  }
+
+  // Drop entries that cancelled out
+  int out = 0;
+  for (int i = 0; i < m_; i++)
+  {
+    int begin = row_ptr_[i], end = row_ptr_[i + 1];
+    row_ptr_[i] = out;
+
+    for (int k = begin; k < end; k++)
+      if (IsNotZero(val_[k], eps))
+      {
+        col_[out] = col_[k];
+        val_[out] = val_[k];
+        out++;
+      }
+  }
+  row_ptr_[m_] = out;
+}
+
+csr_matrix_t csr_matrix_t::transpose() const
+{
+  csr_matrix_t t(n_, m_);
+  t.col_.resize(get_nnz());
+  t.val_.resize(get_nnz());
+
+  CompressedTranspose(m_, n_, row_ptr_.data(), col_.data(), val_.data(),
+                      t.row_ptr_.data(), t.col_.data(), t.val_.data());
+  return t;
+}
+
+// I/O: one sparse row per line
+void csr_matrix_t::write(std::ostream& os) const
+{
+  os << m_ << "x" << n_ << "(" << get_nnz() << "):" << std::endl;
+
+  for (int i = 0; i < m_; i++)
+  {
+    os << i << ": [ ";
+    for (int k = row_ptr_[i]; k < row_ptr_[i + 1]; k++)
+      os << pair_double_t(val_[k], col_[k]) << " ";
+    os << "]" << std::endl;
+  }
+}
+
+std::ostream& operator<<(std::ostream& os, const csr_matrix_t& a)
+{
+  a.write(os);
+  return os;
+}
+
+// -- CSC --
+
+csc_matrix_t::csc_matrix_t(const csr_matrix_t& a)
+    : m_(a.get_m()), n_(a.get_n()), col_ptr_(a.get_n() + 1),
+      row_(a.get_nnz()), val_(a.get_nnz())
+{
+  CompressedTranspose(m_, n_, a.get_row_ptr(), a.get_col(), a.get_val(),
+                      col_ptr_.data(), row_.data(), val_.data());
+}
+
+sparse_vector_t csc_matrix_t::get_col(const int j) const
+{
+  assert(j >= 0 && j < n_);
+
+  pair_vector_t pv(col_ptr_[j + 1] - col_ptr_[j]);
+  for (int k = col_ptr_[j]; k < col_ptr_[j + 1]; k++)
+    pv[k - col_ptr_[j]].set(val_[k], row_[k]);
+
+  return sparse_vector_t(pv, m_);
+}
+
+// Column-oriented product: scatters x[j] times column j into y
+void csc_matrix_t::multiply(const double* x, double* y) const
+{
+  const int* ptr = col_ptr_.data();
+  const int* row = row_.data();
+  const double* val = val_.data();
+
+  for (int i = 0; i < m_; i++)
+    y[i] = 0.0;
+
+  for (int j = 0; j < n_; j++)
+  {
+    double xj = x[j];
+    for (int k = ptr[j]; k < ptr[j + 1]; k++)
+      y[row[k]] += val[k] * xj;
+  }
+}
+
+#endif
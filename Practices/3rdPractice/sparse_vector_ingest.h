@@ -0,0 +1,171 @@
+#ifndef SPARSE_VECTOR_INGEST_H_
+#define SPARSE_VECTOR_INGEST_H_
+
+#include <iostream>
+#include <cassert>
+#include <thread>
+
+#include "vector_t.h"
+#include "pair_t.h"
+#include "sparse_vector_t.h"
+
+// Bits per radix sort digit (256 buckets)
+#define RADIX_BITS 8
+#define RADIX_SIZE (1 << RADIX_BITS)
+
+// Fewer pairs than this per thread are sorted by fewer threads
+#ifndef RADIX_MIN_PAIRS_PER_THREAD
+#define RADIX_MIN_PAIRS_PER_THREAD 65536
+#endif
+
+// What to do with repeated indices in unsorted input
+enum combine_t {
+  COMBINE_SUM,   // add up all the values of the index
+  COMBINE_LAST   // keep the one that came last in the input
+};
+
+// Counts the digit 'shift' of the pairs in [first, last)
+void RadixCount(const pair_double_t* in, const long first, const long last,
+                const int shift, long* hist)
+{
+  for (int d = 0; d < RADIX_SIZE; d++)
+    hist[d] = 0;
+
+  for (long k = first; k < last; k++)
+    hist[(in[k].get_inx() >> shift) & (RADIX_SIZE - 1)]++;
+}
+
+// Moves the pairs in [first, last) to their bucket. 'offset' holds where
+// this chunk's part of every bucket starts in 'out'
+void RadixScatter(const pair_double_t* in, pair_double_t* out,
+                  const long first, const long last,
+                  const int shift, long* offset)
+{
+  for (long k = first; k < last; k++)
+    out[offset[(in[k].get_inx() >> shift) & (RADIX_SIZE - 1)]++] = in[k];
+}
+
+// Stable LSD radix sort by index, one RADIX_BITS digit per pass. Every
+// thread counts its own chunk, the per-(digit, thread) offsets are laid
+// out digit-major so chunks keep their relative order, and then every
+// thread scatters its chunk. Passes over digits that all pairs share are
+// skipped. The sorted pairs end up in 'a' ('tmp' is scratch).
+void RadixSortPairs(pair_double_t* a, pair_double_t* tmp, const long count,
+                    const int max_inx, const int nthreads)
+{
+  int t = nthreads;
+  if (t > count / RADIX_MIN_PAIRS_PER_THREAD)
+    t = (int)(count / RADIX_MIN_PAIRS_PER_THREAD);
+  if (t < 1)
+    t = 1;
+
+  vector_t<long> hist(t * RADIX_SIZE);
+  vector_t<long> bounds(t + 1);
+  for (int k = 0; k <= t; k++)
+    bounds[k] = count * k / t;
+
+  vector_t<std::thread> workers(t - 1);
+  pair_double_t* in = a;
+  pair_double_t* out = tmp;
+
+  for (int shift = 0; shift < 31 && (max_inx >> shift) > 0; shift += RADIX_BITS)
+  {
+    for (int k = 1; k < t; k++)
+      workers[k - 1] = std::thread(RadixCount, in, bounds[k], bounds[k + 1],
+                                   shift, hist.data() + k * RADIX_SIZE);
+    RadixCount(in, bounds[0], bounds[1], shift, hist.data());
+    for (int k = 0; k < t - 1; k++)
+      workers[k].join();
+
+    // If one bucket holds everything this digit does not reorder anything
+    bool trivial = false;
+    for (int d = 0; d < RADIX_SIZE && !trivial; d++)
+    {
+      long total = 0;
+      for (int k = 0; k < t; k++)
+        total += hist[k * RADIX_SIZE + d];
+      trivial = (total == count);
+    }
+    if (trivial)
+      continue;
+
+    // Counts -> offsets: digit by digit, and inside a digit thread by thread
+    long sum = 0;
+    for (int d = 0; d < RADIX_SIZE; d++)
+      for (int k = 0; k < t; k++)
+      {
+        long c = hist[k * RADIX_SIZE + d];
+        hist[k * RADIX_SIZE + d] = sum;
+        sum += c;
+      }
+
+    for (int k = 1; k < t; k++)
+      workers[k - 1] = std::thread(RadixScatter, in, out, bounds[k], bounds[k + 1],
+                                   shift, hist.data() + k * RADIX_SIZE);
+    RadixScatter(in, out, bounds[0], bounds[1], shift, hist.data());
+    for (int k = 0; k < t - 1; k++)
+      workers[k].join();
+
+    pair_double_t* aux = in;
+    in = out;
+    out = aux;
+  }
+
+  if (in != a)
+    for (long k = 0; k < count; k++)
+      a[k] = in[k];
+}
+
+// Builds a sparse vector of size n from 'count' (index, value) pairs in
+// any order, e.g. as read with pair_t::read. Pairs are radix sorted by
+// index (no comparisons, so no std::sort), repeated indices are combined
+// and whatever ends up under eps is dropped.
+//
+// The sort and the combining are done in 'pairs' itself, which is left
+// overwritten: besides it only one scratch buffer of 'count' pairs is
+// held, and freed before the result (nz pairs) is built and moved into
+// the sparse_vector_t.
+sparse_vector_t BuildSparseVector(pair_double_t* pairs, const long count,
+                                  const int n, const combine_t combine = COMBINE_SUM,
+                                  const double eps = EPS, const int nthreads = 1)
+{
+  for (long k = 0; k < count; k++)
+    assert(pairs[k].get_inx() >= 0 && pairs[k].get_inx() < n);
+
+  pair_double_t* tmp = new pair_double_t[count > 0 ? count : 1];
+  RadixSortPairs(pairs, tmp, count, n - 1, nthreads);
+  delete[] tmp;
+
+  // Combine runs of the same index; the sort is stable, so the last pair
+  // of a run is the last one of the input. Every run is written over its
+  // own first pair or an earlier one, so this works in place
+  int nz = 0;
+  for (long k = 0; k < count; )
+  {
+    int inx = pairs[k].get_inx();
+    double val = 0.0;
+
+    for ( ; k < count && pairs[k].get_inx() == inx; k++)
+      val = (combine == COMBINE_SUM) ? val + pairs[k].get_val() : pairs[k].get_val();
+
+    if (IsNotZero(val, eps))
+      pairs[nz++].set(val, inx);
+  }
+
+  pair_vector_t pv(nz);
+  for (int i = 0; i < nz; i++)
+    pv[i] = pairs[i];
+
+  return sparse_vector_t(std::move(pv), n);
+}
+
+// Same, with the pairs in a pair_vector_t (also overwritten)
+sparse_vector_t BuildSparseVector(pair_vector_t& pairs, const int n,
+                                  const combine_t combine = COMBINE_SUM,
+                                  const double eps = EPS, const int nthreads = 1)
+{
+  return BuildSparseVector(pairs.get_size() > 0 ? pairs.data() : NULL,
+                           pairs.get_size(), n, combine, eps, nthreads);
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <math.h>  // fabs
+#include <utility>  // std::move
 
 #include "vector_t.h"
 #include "pair_t.h"
@@ -19,6 +20,8 @@ class sparse_vector_t {
   sparse_vector_t(const int = 0);
   sparse_vector_t(const vector_t<double>&,
                  const double = EPS); // standard constructor
+  sparse_vector_t(const pair_vector_t&, const int);  // from sorted pairs
+  sparse_vector_t(pair_vector_t&&, const int);       // same, taking them
   sparse_vector_t(const sparse_vector_t&);  // copy constructor
 
   // -- Assignment operator --
@@ -90,6 +93,24 @@ sparse_vector_t::sparse_vector_t(const vector_t<double>& v, const double eps)
   }
 }
 
+// Builds the sparse vector straight from pairs that are already sorted
+// by index and free of duplicates (no zero filtering is done here), so
+// other containers can hand their non-zeros over without a dense detour
+sparse_vector_t::sparse_vector_t(const pair_vector_t& pv, const int n)
+    : pv_(pv), nz_(pv.get_size()), n_(n)
+{
+  for (int i = 1; i < nz_; i++)
+    assert(pv_[i - 1].get_inx() < pv_[i].get_inx());
+}
+
+// Same, but the pairs are moved in instead of copied
+sparse_vector_t::sparse_vector_t(pair_vector_t&& pv, const int n)
+    : pv_(std::move(pv)), nz_(pv_.get_size()), n_(n)
+{
+  for (int i = 1; i < nz_; i++)
+    assert(pv_[i - 1].get_inx() < pv_[i].get_inx());
+}
+
 // copy constructor
 sparse_vector_t::sparse_vector_t(const sparse_vector_t& w) 
 {
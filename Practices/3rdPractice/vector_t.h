@@ -10,6 +10,7 @@ template<class T> class vector_t
   // -- Constructors --
   vector_t(const int = 0);
   vector_t(const vector_t&); // copy constructor
+  vector_t(vector_t&&);      // move constructor: takes w's array
 
   // -- Assignment operator --
   vector_t<T>& operator=(const vector_t<T>&);
@@ -32,6 +33,10 @@ template<class T> class vector_t
   const T& at(const int) const;
   const T& operator[](const int) const;
 
+  // -- Raw access (contiguous storage, for tight loops) --
+  T* data(void);
+  const T* data(void) const;
+
   // -- Resizing --
   void resize(const int);
   
@@ -61,6 +66,15 @@ vector_t<T>::vector_t(const vector_t<T>& w)
   *this = w; // Directly invokes assignment operator
 }
 
+// Move constructor: w is left empty
+template<class T>
+vector_t<T>::vector_t(vector_t<T>&& w)
+    : v_(w.v_), sz_(w.sz_)
+{
+  w.v_ = NULL;
+  w.sz_ = 0;
+}
+
 // Assignment operator
 template<class T> vector_t<T>&
 vector_t<T>::operator=(const vector_t<T>& w)
@@ -154,6 +168,18 @@ vector_t<T>::operator[](const int i) const
   return at(i);
 }
 
+template<class T> inline T*
+vector_t<T>::data()
+{
+  return v_;
+}
+
+template<class T> inline const T*
+vector_t<T>::data() const
+{
+  return v_;
+}
+
 template<class T> void
 vector_t<T>::read(std::istream& is)
 {
@@ -0,0 +1,259 @@
+#ifndef FROZEN_SLLPOLYNOMIAL_H_
+#define FROZEN_SLLPOLYNOMIAL_H_
+
+#include <iostream>
+#include <cassert>
+
+#include "sllpolynomial.h"
+
+// Points evaluated side by side by FrozenSllPolynomial::EvalMany
+#ifndef EVAL_LANES
+#define EVAL_LANES 8
+#endif
+
+
+
+// Read-only snapshot of an SllPolynomial for the phases where it is only
+// evaluated: the terms are copied, in ascending exponent order, into two
+// contiguous arrays (exponents and coefficients, structure of arrays), so
+// a pass over them is a sequential read with no pointer chasing and
+// EvalMany can run several points through each term in SIMD lanes.
+//
+// Freeze takes the snapshot and Thaw rebuilds the linked form, for when
+// the polynomial has to be edited again. Eval, IsEqual and WeirdSum take
+// the same arguments and give the same results as in SllPolynomial:
+// Write, Eval and IsEqual are the walks of sllpolynomial_terms.h over
+// the arrays, and only EvalMany and WeirdSum are its own.
+class FrozenSllPolynomial
+{
+ public:
+    // constructors
+    FrozenSllPolynomial(void) : inx_(), val_() {};
+    FrozenSllPolynomial(const SllPolynomial&);
+
+    // destructor
+    ~FrozenSllPolynomial() {};
+
+    // getters
+    int get_size(void) const { return inx_.get_size(); }
+    int get_inx(const int i) const { return inx_[i]; }
+    double get_val(const int i) const { return val_[i]; }
+
+    // freeze & thaw
+    void Freeze(const SllPolynomial&);
+    void Thaw(SllPolynomial&) const;
+
+    // I/O
+    void Write(std::ostream& = std::cout) const;
+
+    // operations
+    double Eval(const double) const;
+    double Eval(const power_table_t&) const;
+    void EvalMany(const double*, double*, const int) const;
+    bool IsEqual(const FrozenSllPolynomial&, const double = EPS) const;
+
+    // Extra modification
+    double WeirdSum(const double c, const int i) const;
+
+ private:
+    vector_t<int> inx_;     // ascending exponents
+    vector_t<double> val_;  // their coefficients
+};
+
+
+
+// Term cursor (see sllpolynomial_terms.h): a position in the arrays
+class frozen_cursor_t
+{
+ public:
+    // constructors
+    frozen_cursor_t(const FrozenSllPolynomial& pol) : pol_(pol), i_(0) {}
+
+    // getters
+    bool valid(void) const { return i_ < pol_.get_size(); }
+    int get_inx(void) const { return pol_.get_inx(i_); }
+    double get_val(void) const { return pol_.get_val(i_); }
+
+    // operations
+    void next(void) { i_++; }
+
+ private:
+    const FrozenSllPolynomial& pol_;
+    int i_;
+};
+
+
+
+// constructor
+FrozenSllPolynomial::FrozenSllPolynomial(const SllPolynomial& pol)
+    : inx_(), val_()
+{
+    Freeze(pol);
+}
+
+
+
+// The terms must be in ascending exponent order, as the constructor and
+// the operations of SllPolynomial leave them (lists built by hand with
+// push_front can be put in order with Sort first)
+void
+FrozenSllPolynomial::Freeze(const SllPolynomial& pol)
+{
+    inx_.resize(pol.get_size());
+    val_.resize(pol.get_size());
+
+    int i{0};
+    for (SllPolyNode* aux{pol.get_head()}; aux != NULL; aux = aux->get_next(), i++)
+    {
+        inx_[i] = aux->get_data().get_inx();
+        val_[i] = aux->get_data().get_val();
+        assert(i == 0 || inx_[i - 1] < inx_[i]);
+    }
+}
+
+
+
+// Back to a linked list, which must start empty
+void
+FrozenSllPolynomial::Thaw(SllPolynomial& pol) const
+{
+    assert(pol.empty());
+
+    for (int i{0}; i < get_size(); i++)
+        pol.push_back(new SllPolyNode(pair_double_t(val_[i], inx_[i])));
+}
+
+
+
+// I/O
+void
+FrozenSllPolynomial::Write(std::ostream& os) const
+{
+    TermsWrite(os, frozen_cursor_t(*this));
+}
+
+
+
+std::ostream&
+operator<<(std::ostream& os, const FrozenSllPolynomial& p) {
+    p.Write(os);
+    return os;
+}
+
+
+
+// -- OPERATIONS WITH POLYNOMIALS --
+
+// The running power of TermsEval, over the arrays
+double
+FrozenSllPolynomial::Eval(const double x) const {
+    return TermsEval(frozen_cursor_t(*this), x);
+}
+
+
+
+double
+FrozenSllPolynomial::Eval(const power_table_t& pt) const {
+    return TermsEval(frozen_cursor_t(*this), pt);
+}
+
+
+
+// Evaluation at n points: out[k] = Eval(xs[k]).
+// EVAL_LANES points walk the terms together. The gap between exponents is
+// the same for all of them, so every lane does the same squarings and
+// multiplies: independent operations the compiler can put in SIMD
+// registers, with each term loaded once per group
+void
+FrozenSllPolynomial::EvalMany(const double* xs, double* out, const int n) const
+{
+    int k{0};
+
+    for ( ; k + EVAL_LANES <= n; k += EVAL_LANES)
+    {
+        double power[EVAL_LANES], acc[EVAL_LANES], sq[EVAL_LANES], step[EVAL_LANES];
+        for (int l{0}; l < EVAL_LANES; l++)
+        {
+            power[l] = 1.0;
+            acc[l] = 0.0;
+        }
+
+        power_anchor_t anchor(PowerSpan(xs[k]));
+        for (int i{0}; i < get_size(); i++)
+        {
+            // x^inx from scratch where Eval takes it so, else times x^gap
+            int gap{0};
+            if (anchor.step(inx_[i]))
+                for (int l{0}; l < EVAL_LANES; l++)
+                    power[l] = AnchorPow(xs[k + l], inx_[i]);
+            else
+                gap = anchor.get_gap();
+
+            // IntPow(x, gap) in every lane
+            for (int l{0}; l < EVAL_LANES; l++)
+            {
+                sq[l] = xs[k + l];
+                step[l] = 1.0;
+            }
+            for ( ; gap > 0; gap >>= 1)
+            {
+                if (gap & 1)
+                    for (int l{0}; l < EVAL_LANES; l++)
+                        step[l] *= sq[l];
+                for (int l{0}; l < EVAL_LANES; l++)
+                    sq[l] *= sq[l];
+            }
+            for (int l{0}; l < EVAL_LANES; l++)
+                power[l] *= step[l];
+
+            const double val{val_[i]};
+            for (int l{0}; l < EVAL_LANES; l++)
+                acc[l] += val * power[l];
+        }
+
+        for (int l{0}; l < EVAL_LANES; l++)
+            out[k + l] = acc[l];
+    }
+
+    // Leftover points, one at a time
+    for ( ; k < n; k++)
+        out[k] = Eval(xs[k]);
+}
+
+
+
+bool
+FrozenSllPolynomial::IsEqual(const FrozenSllPolynomial& pol, const double eps) const
+{
+    return TermsIsEqual(frozen_cursor_t(*this), frozen_cursor_t(pol), eps);
+}
+
+
+
+// Extra modification: same as SllPolynomial::WeirdSum. The terms with
+// exponent <= i are found by binary search, and the sum over them has no
+// branch to mispredict
+double
+FrozenSllPolynomial::WeirdSum(const double c, const int i) const
+{
+    int lo{0};
+    int hi{get_size()};  // first exponent > i in [lo, hi]
+    while (lo < hi)
+    {
+        int mid{lo + (hi - lo) / 2};
+        if (inx_[mid] <= i)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    double result{0.0};
+    for (int k{0}; k < lo; k++)
+        result += (val_[k] > c) ? val_[k] : 0.0;
+
+    return result;
+}
+
+
+
+#endif  // FROZEN_SLLPOLYNOMIAL_H_
@@ -0,0 +1,249 @@
+#ifndef HAZARD_POINTERT_H_
+#define HAZARD_POINTERT_H_
+
+#include <cassert>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>  // std::sort, std::binary_search
+
+// Threads that can hold hazard pointers at the same time
+#ifndef HP_MAX_THREADS
+#define HP_MAX_THREADS 256
+#endif
+
+// Hazard pointers per thread (a list traversal needs three)
+#define HP_PER_THREAD 3
+
+// Bytes of a cache line: every thread's record starts on a line of its own
+#ifndef HP_CACHE_LINE
+#define HP_CACHE_LINE 64
+#endif
+
+// Retired nodes a thread piles up before it scans the hazard pointers
+#define HP_SCAN_THRESHOLD (2 * HP_PER_THREAD * 64)
+
+
+
+// Hazard pointers (Michael, 2004): safe memory reclamation for lock-free
+// structures. Before dereferencing a shared node, a thread publishes its
+// address in one of its hazard pointers and checks that the node is
+// still reachable. A node that has been unlinked is "retired" instead of
+// deleted, and only freed once no hazard pointer points to it, so no
+// thread can ever read freed memory. Each retire is O(1) amortized: the
+// hazard pointers are only scanned every HP_SCAN_THRESHOLD retires.
+//
+// There is one domain for the whole program, shared by all types (a
+// retired node carries its own deleter). Every thread takes a record
+// the first time it uses one and gives it back when it ends, with
+// whatever nodes it could not free yet.
+class hazard_pointer_t
+{
+ public:
+    // operations
+    static void protect(const int, const void*);  // slot, pointer
+    static void clear(void);                       // every slot of the thread
+    static void retire(void*, void (*)(void*));    // node, its deleter
+
+ private:
+    // one cache line (or more) per record, so the stores of protect() in
+    // one thread do not invalidate the records of its neighbours
+    struct alignas(HP_CACHE_LINE) record_t
+    {
+        std::atomic<bool> active_;
+        std::atomic<const void*> hp_[HP_PER_THREAD];
+    };
+
+    struct retired_t
+    {
+        void* p_;
+        void (*deleter_)(void*);
+    };
+
+    // what a thread keeps: its record and its retired nodes
+    struct thread_t
+    {
+        record_t* record_;
+        std::vector<retired_t> retired_;
+
+        thread_t(void);
+        ~thread_t(void);
+    };
+
+    static record_t* records(void);
+    static std::atomic<int>& used(void);     // records ever taken
+    static std::mutex& orphans_mutex(void);
+    static std::vector<retired_t>& orphans(void);  // of threads that ended
+
+    static thread_t& self(void);
+    static void scan(std::vector<retired_t>&);
+};
+
+
+
+// Zero-initialized storage: every record starts inactive and empty
+inline hazard_pointer_t::record_t*
+hazard_pointer_t::records(void)
+{
+    static record_t r[HP_MAX_THREADS];
+    return r;
+}
+
+
+
+inline std::atomic<int>&
+hazard_pointer_t::used(void)
+{
+    static std::atomic<int> u(0);
+    return u;
+}
+
+
+
+// Never destroyed: threads can end after the static objects are gone
+inline std::mutex&
+hazard_pointer_t::orphans_mutex(void)
+{
+    static std::mutex* m = new std::mutex;
+    return *m;
+}
+
+
+
+inline std::vector<hazard_pointer_t::retired_t>&
+hazard_pointer_t::orphans(void)
+{
+    static std::vector<retired_t>* o = new std::vector<retired_t>;
+    return *o;
+}
+
+
+
+// Takes the first inactive record
+inline
+hazard_pointer_t::thread_t::thread_t(void) : record_(NULL), retired_()
+{
+    record_t* r{records()};
+
+    for (int i{0}; i < HP_MAX_THREADS; i++)
+    {
+        bool expected{false};
+        if (!r[i].active_.load() && r[i].active_.compare_exchange_strong(expected, true))
+        {
+            record_ = &r[i];
+            int u{used().load()};
+            while (u < i + 1 && !used().compare_exchange_weak(u, i + 1))
+                ;
+            break;
+        }
+    }
+
+    assert(record_ != NULL);  // more than HP_MAX_THREADS threads
+}
+
+
+
+// Frees what it can and leaves the rest to the next thread that scans
+inline
+hazard_pointer_t::thread_t::~thread_t(void)
+{
+    for (int k{0}; k < HP_PER_THREAD; k++)
+        record_->hp_[k].store(NULL);
+
+    scan(retired_);
+    if (!retired_.empty())
+    {
+        std::lock_guard<std::mutex> lock(orphans_mutex());
+        orphans().insert(orphans().end(), retired_.begin(), retired_.end());
+    }
+
+    record_->active_.store(false);
+}
+
+
+
+inline hazard_pointer_t::thread_t&
+hazard_pointer_t::self(void)
+{
+    static thread_local thread_t t;
+    return t;
+}
+
+// -- OPERATIONS --
+
+inline void
+hazard_pointer_t::protect(const int slot, const void* p)
+{
+    assert(slot >= 0 && slot < HP_PER_THREAD);
+    self().record_->hp_[slot].store(p);
+}
+
+
+
+inline void
+hazard_pointer_t::clear(void)
+{
+    record_t* r{self().record_};
+    for (int k{0}; k < HP_PER_THREAD; k++)
+        r->hp_[k].store(NULL);
+}
+
+
+
+inline void
+hazard_pointer_t::retire(void* p, void (*deleter)(void*))
+{
+    thread_t& t{self()};
+
+    retired_t r = { p, deleter };
+    t.retired_.push_back(r);
+
+    if ((int)t.retired_.size() >= HP_SCAN_THRESHOLD)
+    {
+        // Adopt the nodes of threads that ended, if nobody else is
+        std::unique_lock<std::mutex> lock(orphans_mutex(), std::try_to_lock);
+        if (lock.owns_lock())
+        {
+            t.retired_.insert(t.retired_.end(), orphans().begin(), orphans().end());
+            orphans().clear();
+            lock.unlock();
+        }
+
+        scan(t.retired_);
+    }
+}
+
+
+
+// Deletes the retired nodes no hazard pointer points to, keeps the rest
+inline void
+hazard_pointer_t::scan(std::vector<retired_t>& retired)
+{
+    std::vector<const void*> hazards;
+    record_t* r{records()};
+    const int n{used().load()};
+
+    for (int i{0}; i < n; i++)
+        for (int k{0}; k < HP_PER_THREAD; k++)
+        {
+            const void* p{r[i].hp_[k].load()};
+            if (p != NULL)
+                hazards.push_back(p);
+        }
+
+    std::sort(hazards.begin(), hazards.end());
+
+    size_t kept{0};
+    for (size_t i{0}; i < retired.size(); i++)
+        if (std::binary_search(hazards.begin(), hazards.end(),
+                               (const void*)retired[i].p_))
+            retired[kept++] = retired[i];
+        else
+            retired[i].deleter_(retired[i].p_);
+
+    retired.resize(kept);
+}
+
+
+
+#endif  // HAZARD_POINTERT_H_
@@ -0,0 +1,327 @@
+#ifndef LOCKFREE_SLLT_H_
+#define LOCKFREE_SLLT_H_
+
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <cstdint>     // uintptr_t
+#include <functional>  // std::less
+#include <vector>
+
+#include "hazard_pointer_t.h"
+
+
+
+// Node of lockfree_sll_t. The lowest bit of next_ is the deletion mark
+// (nodes are at least 2-aligned, so it is free): a node whose next_ is
+// marked has been logically removed, and its link can no longer change
+template <class T> class lockfree_node_t
+{
+ public:
+    // constructors
+    lockfree_node_t(const T& data) : next_(0), data_(data) {}
+
+    // getters
+    const T& get_data(void) const { return data_; }
+
+    // for the list
+    std::atomic<uintptr_t> next_;
+
+    static void destroy(void* p) { delete static_cast<lockfree_node_t<T>*>(p); }
+
+ private:
+    T data_;
+};
+
+
+
+// Sorted singly linked list that any number of threads can update and
+// read at the same time without locks (Harris' list, with Michael's
+// hazard pointers for memory reclamation).
+//
+//   insert: find the place, link the new node with one CAS on the
+//           predecessor's next_; retry if it changed meanwhile
+//   erase:  mark the node's next_ (logical deletion, by CAS), then try
+//           to unlink it with a CAS on the predecessor
+//
+// Every traversal unlinks the marked nodes it meets, so an erase whose
+// unlinking failed is finished by whoever passes by next. Unlinked nodes
+// are retired to hazard_pointer_t, not deleted, so a thread still
+// standing on one can keep going. Some thread always makes progress.
+//
+// Elements are unique by 'Less'. As in sll_t there is search and write,
+// but search answers with a copy of the element: a node pointer would
+// not be safe to use once the call returns. get_size is exact when no
+// update is in progress. The destructor is not concurrent.
+template <class T, class Less = std::less<T> > class lockfree_sll_t
+{
+ public:
+    typedef lockfree_node_t<T> node_t;
+
+    // constructor
+    lockfree_sll_t(void) : head_(0), size_(0), less_() {}
+
+    // destructor
+    ~lockfree_sll_t(void);
+
+    // getters
+    int get_size(void) const { return size_.load(); }
+    bool empty(void) const { return get_size() == 0; }
+
+    // operations
+    bool insert(const T&);  // false if it was already there
+    bool erase(const T&);   // false if it was not there
+
+    bool search(const T&) const;
+    bool search(const T&, T&) const;  // with the element in the list
+
+    void snapshot(std::vector<T>&) const;  // the elements, in order
+
+    // I/O
+    std::ostream& write(std::ostream& = std::cout) const;
+
+ private:
+    mutable std::atomic<uintptr_t> head_;
+    std::atomic<int> size_;
+    Less less_;
+
+    // hazard pointer slots
+    enum { HP_NEXT = 0, HP_CUR = 1, HP_PREV = 2 };
+
+    static node_t* ptr(const uintptr_t p) { return (node_t*)(p & ~(uintptr_t)1); }
+    static bool marked(const uintptr_t p) { return (p & 1) != 0; }
+
+    bool find(const T&, std::atomic<uintptr_t>*&, node_t*&, node_t*&) const;
+
+    lockfree_sll_t(const lockfree_sll_t<T, Less>&);  // not copyable
+};
+
+
+
+// destructor
+template <class T, class Less>
+lockfree_sll_t<T, Less>::~lockfree_sll_t(void)
+{
+    node_t* aux{ptr(head_.load())};
+    while (aux != NULL)
+    {
+        node_t* next{ptr(aux->next_.load())};
+        delete aux;
+        aux = next;
+    }
+}
+
+
+
+// Michael's search: on return, prev is the link that pointed to cur (an
+// unmarked one, just checked), cur is the first node not less than d
+// (or NULL) and next its successor. cur and the node holding prev are
+// protected by hazard pointers until the next call or clear().
+// Marked nodes found on the way are unlinked and retired. Returns
+// whether cur holds d.
+template <class T, class Less> bool
+lockfree_sll_t<T, Less>::find(const T& d, std::atomic<uintptr_t>*& prev,
+                              node_t*& cur, node_t*& next) const
+{
+retry:
+    prev = &head_;
+    cur = ptr(prev->load());
+
+    for (;;)
+    {
+        if (cur == NULL)
+            return false;
+
+        // cur is safe to read once it is protected and still linked
+        hazard_pointer_t::protect(HP_CUR, cur);
+        if (prev->load() != (uintptr_t)cur)
+            goto retry;
+
+        const uintptr_t link{cur->next_.load()};
+        next = ptr(link);
+        hazard_pointer_t::protect(HP_NEXT, next);
+        if (cur->next_.load() != link)
+            goto retry;
+
+        if (marked(link))
+        {
+            // cur is deleted: unlink it; next is protected, so it can
+            // be the new cur right away
+            uintptr_t expected{(uintptr_t)cur};
+            if (!prev->compare_exchange_strong(expected, (uintptr_t)next))
+                goto retry;
+            hazard_pointer_t::retire(cur, &node_t::destroy);
+            cur = next;
+        }
+        else
+        {
+            if (!less_(cur->get_data(), d))
+                return !less_(d, cur->get_data());
+
+            prev = &cur->next_;
+            hazard_pointer_t::protect(HP_PREV, cur);
+            cur = next;
+        }
+    }
+}
+
+// -- OPERATIONS --
+
+template <class T, class Less> bool
+lockfree_sll_t<T, Less>::insert(const T& d)
+{
+    node_t* n{new node_t(d)};
+    std::atomic<uintptr_t>* prev;
+    node_t* cur;
+    node_t* next;
+
+    for (;;)
+    {
+        if (find(d, prev, cur, next))
+        {
+            delete n;
+            hazard_pointer_t::clear();
+            return false;
+        }
+
+        n->next_.store((uintptr_t)cur);
+        uintptr_t expected{(uintptr_t)cur};
+        if (prev->compare_exchange_strong(expected, (uintptr_t)n))
+        {
+            size_++;
+            hazard_pointer_t::clear();
+            return true;
+        }
+    }
+}
+
+
+
+template <class T, class Less> bool
+lockfree_sll_t<T, Less>::erase(const T& d)
+{
+    std::atomic<uintptr_t>* prev;
+    node_t* cur;
+    node_t* next;
+
+    for (;;)
+    {
+        if (!find(d, prev, cur, next))
+        {
+            hazard_pointer_t::clear();
+            return false;
+        }
+
+        // Logical deletion: whoever marks cur has erased it
+        uintptr_t link{(uintptr_t)next};
+        if (!cur->next_.compare_exchange_strong(link, link | 1))
+            continue;
+        size_--;
+
+        // Physical deletion, or leave it to a find (which does it now)
+        uintptr_t expected{(uintptr_t)cur};
+        if (prev->compare_exchange_strong(expected, (uintptr_t)next))
+            hazard_pointer_t::retire(cur, &node_t::destroy);
+        else
+            find(d, prev, cur, next);
+
+        hazard_pointer_t::clear();
+        return true;
+    }
+}
+
+
+
+template <class T, class Less> bool
+lockfree_sll_t<T, Less>::search(const T& d) const
+{
+    std::atomic<uintptr_t>* prev;
+    node_t* cur;
+    node_t* next;
+
+    const bool found{find(d, prev, cur, next)};
+    hazard_pointer_t::clear();
+
+    return found;
+}
+
+
+
+template <class T, class Less> bool
+lockfree_sll_t<T, Less>::search(const T& d, T& out) const
+{
+    std::atomic<uintptr_t>* prev;
+    node_t* cur;
+    node_t* next;
+
+    const bool found{find(d, prev, cur, next)};
+    if (found)
+        out = cur->get_data();  // still protected
+    hazard_pointer_t::clear();
+
+    return found;
+}
+
+
+
+// find's walk to the end, copying every live node. It unlinks the
+// marked ones too, as it must: it can only step past nodes that are
+// still linked. If it has to restart, the copy starts over, so the
+// result is always an ordered run of elements that were in the list
+template <class T, class Less> void
+lockfree_sll_t<T, Less>::snapshot(std::vector<T>& v) const
+{
+retry:
+    v.clear();
+    std::atomic<uintptr_t>* prev{&head_};
+    node_t* cur{ptr(prev->load())};
+
+    while (cur != NULL)
+    {
+        hazard_pointer_t::protect(HP_CUR, cur);
+        if (prev->load() != (uintptr_t)cur)
+            goto retry;
+
+        const uintptr_t link{cur->next_.load()};
+        node_t* next{ptr(link)};
+        hazard_pointer_t::protect(HP_NEXT, next);
+        if (cur->next_.load() != link)
+            goto retry;
+
+        if (marked(link))
+        {
+            uintptr_t expected{(uintptr_t)cur};
+            if (!prev->compare_exchange_strong(expected, (uintptr_t)next))
+                goto retry;
+            hazard_pointer_t::retire(cur, &node_t::destroy);
+        }
+        else
+        {
+            v.push_back(cur->get_data());
+            prev = &cur->next_;
+            hazard_pointer_t::protect(HP_PREV, cur);
+        }
+        cur = next;
+    }
+
+    hazard_pointer_t::clear();
+}
+
+
+
+// I/O
+template <class T, class Less>
+std::ostream& lockfree_sll_t<T, Less>::write(std::ostream& os) const
+{
+    std::vector<T> v;
+    snapshot(v);
+
+    for (size_t i{0}; i < v.size(); i++)
+        os << v[i];
+
+    return os;
+}
+
+
+
+#endif  // LOCKFREE_SLLT_H_
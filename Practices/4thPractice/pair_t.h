@@ -12,8 +12,9 @@ template<class T> class pair_t
     pair_t(void); 
     pair_t(T, int);
 
-    // destructor
-    ~pair_t(void);
+    // destructor (defaulted, so pairs are trivially destructible and a
+    // list of them can be freed without visiting every node)
+    ~pair_t(void) = default;
 
     // getters & setters
     T get_val(void) const;
@@ -39,10 +40,6 @@ template<class T> pair_t<T>::pair_t(T val, int inx) : val_(val), inx_(inx) {}
 
 
 
-template<class T> pair_t<T>::~pair_t() {}
-
-
-
 template<class T> void
 pair_t<T>::set(T val, int inx)
 {
@@ -93,4 +90,29 @@ std::ostream& operator<<(std::ostream& os, const pair_t<T>& p)
 
 
 
+// Order of pairs by index alone, e.g. to keep the terms of a
+// polynomial sorted by exponent
+template<class T> struct pair_inx_less
+{
+    bool operator()(const pair_t<T>& a, const pair_t<T>& b) const
+    {
+        return a.get_inx() < b.get_inx();
+    }
+};
+
+
+
+// Merges two pairs with the same index by adding their values (for
+// sll_t::sort)
+template<class T> struct pair_val_add
+{
+    bool operator()(pair_t<T>& a, const pair_t<T>& b) const
+    {
+        a.set(a.get_val() + b.get_val(), a.get_inx());
+        return true;
+    }
+};
+
+
+
 #endif  // PAIRT_H_
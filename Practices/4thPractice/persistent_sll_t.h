@@ -0,0 +1,273 @@
+#ifndef PERSISTENT_SLLT_H_
+#define PERSISTENT_SLLT_H_
+
+#include <iostream>
+#include <cassert>
+#include <atomic>
+
+
+
+// Node of persistent_sll_t: immutable once linked, and freed when the
+// last list or node pointing to it lets it go. Every node holds one
+// reference to the node after it
+template <class T> class persistent_node_t
+{
+ public:
+    // constructors
+    persistent_node_t(const T& data, persistent_node_t<T>* next)
+        : data_(data), next_(next), refs_(1) {}
+
+    // getters
+    persistent_node_t<T>* get_next(void) const { return next_; }
+    const T& get_data(void) const { return data_; }
+    int get_refs(void) const { return refs_.load(std::memory_order_relaxed); }
+
+    // references
+    static void acquire(persistent_node_t<T>*);
+    static void release(persistent_node_t<T>*);
+
+    // E/S
+    std::ostream& write(std::ostream& = std::cout) const;
+
+ private:
+    T data_;
+    persistent_node_t<T>* next_;
+    std::atomic<int> refs_;
+
+    template <class> friend class persistent_sll_t;  // links the copies
+
+    persistent_node_t(const persistent_node_t<T>&);  // not copyable
+};
+
+
+
+template <class T> void
+persistent_node_t<T>::acquire(persistent_node_t<T>* p)
+{
+    if (p != NULL)
+        p->refs_.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+
+// Iterative, so freeing a long chain does not recurse down the list
+template <class T> void
+persistent_node_t<T>::release(persistent_node_t<T>* p)
+{
+    while (p != NULL && p->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        persistent_node_t<T>* next{p->next_};
+        delete p;
+        p = next;
+    }
+}
+
+
+
+// I/O
+template <class T>
+std::ostream& persistent_node_t<T>::write(std::ostream& os) const
+{
+    os << data_;
+    return os;
+}
+
+
+
+// Singly linked list whose versions share structure. Nodes are never
+// changed after they are linked, so copying a list only copies its head
+// pointer (O(1)) and both copies share every node. A change at position
+// pos copies the pos nodes before it and links the copies to the
+// untouched rest, which stays shared with the other versions: O(pos)
+// time and memory instead of a copy of the whole list. Nodes are
+// reference counted and freed with the last version that uses them.
+//
+// The counts are atomic, so versions sharing nodes can be used and
+// dropped from different threads; a single version is not thread safe.
+template <class T> class persistent_sll_t
+{
+ public:
+    typedef persistent_node_t<T> node_t;
+
+    // constructors
+    persistent_sll_t(void) : head_(NULL), size_(0) {}
+    persistent_sll_t(const persistent_sll_t<T>&);  // shares every node
+
+    // assignment operator
+    persistent_sll_t<T>& operator=(const persistent_sll_t<T>&);
+
+    // destructor
+    ~persistent_sll_t(void) { node_t::release(head_); }
+
+    // getters
+    node_t* get_head(void) const { return head_; }
+    int get_size(void) const { return size_; }
+
+    bool empty(void) const { return head_ == NULL; }
+
+    // operations, all at a position from the head
+    void clear(void);
+    void push_front(const T&);  // O(1)
+    void pop_front(void);       // O(1)
+    void insert(const int, const T&);
+    void erase(const int);
+    void set(const int, const T&);
+
+    // I/O
+    std::ostream& write(std::ostream& = std::cout) const;
+
+ private:
+    node_t* head_;
+    int size_;
+
+    node_t* at(const int) const;
+    void replace_prefix(const int, node_t*, node_t*);
+};
+
+
+
+template <class T>
+persistent_sll_t<T>::persistent_sll_t(const persistent_sll_t<T>& l)
+    : head_(l.head_), size_(l.size_)
+{
+    node_t::acquire(head_);
+}
+
+
+
+template <class T> persistent_sll_t<T>&
+persistent_sll_t<T>::operator=(const persistent_sll_t<T>& l)
+{
+    node_t::acquire(l.head_);  // first, in case l is this
+    node_t::release(head_);
+    head_ = l.head_;
+    size_ = l.size_;
+
+    return *this;
+}
+
+
+
+template <class T> typename persistent_sll_t<T>::node_t*
+persistent_sll_t<T>::at(const int pos) const
+{
+    assert(pos >= 0 && pos <= size_);
+
+    node_t* aux{head_};
+    for (int k{0}; k < pos; k++)
+        aux = aux->get_next();
+
+    return aux;
+}
+
+
+
+// The new head_ is a copy of the first pos nodes followed by 'middle'
+// (a new node whose next is 'rest', or NULL) and then 'rest', a node of
+// the old version that stays shared. The old nodes are only let go at the
+// end, once 'rest' is held by its new predecessor
+template <class T> void
+persistent_sll_t<T>::replace_prefix(const int pos, node_t* middle, node_t* rest)
+{
+    node_t::acquire(rest);
+
+    node_t* first{NULL};
+    node_t* last{NULL};
+    node_t* aux{head_};
+
+    for (int k{0}; k < pos; k++, aux = aux->get_next())
+    {
+        node_t* copy{new node_t(aux->get_data(), NULL)};
+        if (last == NULL)
+            first = copy;
+        else
+            last->next_ = copy;
+        last = copy;
+    }
+
+    node_t* tail{(middle != NULL) ? middle : rest};
+    if (last == NULL)
+        first = tail;
+    else
+        last->next_ = tail;
+
+    node_t::release(head_);
+    head_ = first;
+}
+
+// -- OPERATIONS --
+
+template <class T> void
+persistent_sll_t<T>::clear(void)
+{
+    node_t::release(head_);
+    head_ = NULL;
+    size_ = 0;
+}
+
+
+
+template <class T> void
+persistent_sll_t<T>::push_front(const T& data)
+{
+    head_ = new node_t(data, head_);  // the list's reference goes to it
+    size_++;
+}
+
+
+
+template <class T> void
+persistent_sll_t<T>::pop_front(void)
+{
+    assert(!empty());
+    replace_prefix(0, NULL, head_->get_next());
+    size_--;
+}
+
+
+
+template <class T> void
+persistent_sll_t<T>::insert(const int pos, const T& data)
+{
+    node_t* rest{at(pos)};
+    node_t::acquire(rest);  // for the new node
+    replace_prefix(pos, new node_t(data, rest), NULL);
+    size_++;
+}
+
+
+
+template <class T> void
+persistent_sll_t<T>::erase(const int pos)
+{
+    assert(pos < size_);
+    replace_prefix(pos, NULL, at(pos)->get_next());
+    size_--;
+}
+
+
+
+template <class T> void
+persistent_sll_t<T>::set(const int pos, const T& data)
+{
+    assert(pos < size_);
+    node_t* rest{at(pos)->get_next()};
+    node_t::acquire(rest);
+    replace_prefix(pos, new node_t(data, rest), NULL);
+}
+
+
+
+// I/O
+template <class T>
+std::ostream& persistent_sll_t<T>::write(std::ostream& os) const
+{
+    for (node_t* aux{head_}; aux != NULL; aux = aux->get_next())
+        aux->write(os);
+
+    return os;
+}
+
+
+
+#endif  // PERSISTENT_SLLT_H_
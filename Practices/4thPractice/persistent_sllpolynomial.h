@@ -0,0 +1,214 @@
+#ifndef PERSISTENT_SLLPOLYNOMIAL_H_
+#define PERSISTENT_SLLPOLYNOMIAL_H_
+
+#include <iostream>
+#include <math.h>  // fabs
+#include <vector>
+
+#include "sllpolynomial.h"
+#include "persistent_sll_t.h"
+
+typedef persistent_node_t<pair_double_t> PersistentPolyNode;
+
+
+
+// Polynomial with cheap versions: copying one is O(1) and shares all of
+// its terms, and changing a term of a copy (Set, Add) only copies the
+// terms of lower exponent, while the higher ones stay shared with the
+// versions it came from. Made for many versions of a polynomial that
+// differ from their parents in a few low-order terms. Terms are in
+// ascending exponent order, as in SllPolynomial.
+class PersistentSllPolynomial : public persistent_sll_t<pair_double_t>
+{
+ public:
+    // constructors
+    PersistentSllPolynomial(void) : persistent_sll_t() {};
+    PersistentSllPolynomial(const vector_t<double>&, const double = EPS);
+    PersistentSllPolynomial(const SllPolynomial&);
+
+    // destructor
+    ~PersistentSllPolynomial() {};
+
+    // I/O
+    void Write(std::ostream& = std::cout) const;
+
+    // getters & setters, on this version only
+    double Get(const int) const;  // coefficient of x^inx
+    void Set(const int, const double, const double = EPS);
+    void Add(const int, const double, const double = EPS);
+
+    // operations
+    double Eval(const double) const;
+    bool IsEqual(const PersistentSllPolynomial&, const double = EPS) const;
+
+    // Extra modification
+    double WeirdSum(const double c, const int i) const;
+
+ private:
+    int find(const int, PersistentPolyNode*&) const;
+};
+
+
+
+// constructors
+// Pushed from the highest exponent down, so each term is O(1)
+PersistentSllPolynomial::PersistentSllPolynomial(const vector_t<double>& v,
+                                                 const double eps)
+{
+    for (int i{v.get_size() - 1}; i >= 0; --i)
+        if (IsNotZero(v[i], eps))
+            push_front(pair_double_t(v[i], i));
+}
+
+
+
+PersistentSllPolynomial::PersistentSllPolynomial(const SllPolynomial& pol)
+{
+    std::vector<pair_double_t> terms;
+    terms.reserve(pol.get_size());
+
+    for (SllPolyNode* aux{pol.get_head()}; aux != NULL; aux = aux->get_next())
+        terms.push_back(aux->get_data());
+
+    for (int k{(int)terms.size() - 1}; k >= 0; --k)
+        push_front(terms[k]);
+}
+
+
+
+// I/O
+void
+PersistentSllPolynomial::Write(std::ostream& os) const
+{
+    TermsWrite(os, NodeCursor(get_head()));
+}
+
+
+
+std::ostream&
+operator<<(std::ostream& os, const PersistentSllPolynomial& p) {
+    p.Write(os);
+    return os;
+}
+
+
+
+// -- GETTERS & SETTERS --
+
+// Position of the first term with exponent >= inx (get_size() if none),
+// and that term in 'node' (or NULL)
+int
+PersistentSllPolynomial::find(const int inx, PersistentPolyNode*& node) const
+{
+    int pos{0};
+    for (node = get_head(); node != NULL && node->get_data().get_inx() < inx;
+         node = node->get_next())
+        pos++;
+
+    return pos;
+}
+
+
+
+double
+PersistentSllPolynomial::Get(const int inx) const
+{
+    PersistentPolyNode* node;
+    find(inx, node);
+
+    return (node != NULL && node->get_data().get_inx() == inx) ?
+           node->get_data().get_val() : 0.0;
+}
+
+
+
+// Coefficients that are not IsNotZero are not stored: setting one to
+// (about) zero removes the term. Only this version changes
+void
+PersistentSllPolynomial::Set(const int inx, const double val, const double eps)
+{
+    assert(inx >= 0);
+
+    PersistentPolyNode* node;
+    const int pos{find(inx, node)};
+    const bool there{node != NULL && node->get_data().get_inx() == inx};
+
+    if (IsNotZero(val, eps))
+    {
+        if (there)
+            set(pos, pair_double_t(val, inx));
+        else
+            insert(pos, pair_double_t(val, inx));
+    }
+    else if (there)
+        erase(pos);
+}
+
+
+
+void
+PersistentSllPolynomial::Add(const int inx, const double val, const double eps)
+{
+    Set(inx, Get(inx) + val, eps);
+}
+
+
+
+// -- OPERATIONS WITH POLYNOMIALS --
+
+// The running power of TermsEval
+double
+PersistentSllPolynomial::Eval(const double x) const {
+    return TermsEval(NodeCursor(get_head()), x);
+}
+
+
+
+// Merge by exponent, as SllPolynomial::IsEqual. Two versions of the same
+// polynomial meet at the first node they share, and from there on they
+// are the same terms: only the parts that differ are compared
+bool
+PersistentSllPolynomial::IsEqual(const PersistentSllPolynomial& pol,
+                                 const double eps) const
+{
+    PersistentPolyNode* aux1{get_head()};
+    PersistentPolyNode* aux2{pol.get_head()};
+
+    while (aux1 != aux2)
+    {
+        int inx1{aux1 != NULL ? aux1->get_data().get_inx() : -1};
+        int inx2{aux2 != NULL ? aux2->get_data().get_inx() : -1};
+
+        double val1{0.0};
+        double val2{0.0};
+
+        if (inx2 < 0 || (inx1 >= 0 && inx1 <= inx2))
+        {
+            val1 = aux1->get_data().get_val();
+            aux1 = aux1->get_next();
+        }
+        if (inx1 < 0 || (inx2 >= 0 && inx2 <= inx1))
+        {
+            val2 = aux2->get_data().get_val();
+            aux2 = aux2->get_next();
+        }
+
+        if (fabs(val1 - val2) > eps)
+            return false;
+    }
+
+    return true;
+}
+
+
+
+// Extra modification: same as SllPolynomial::WeirdSum
+double
+PersistentSllPolynomial::WeirdSum(const double c, const int i) const
+{
+    return TermsWeirdSum(NodeCursor(get_head()), c, i);
+}
+
+
+
+#endif  // PERSISTENT_SLLPOLYNOMIAL_H_
@@ -0,0 +1,267 @@
+#ifndef SKIP_LISTT_H_
+#define SKIP_LISTT_H_
+
+#include <iostream>
+#include <cassert>
+#include <functional>  // std::less
+
+#include "skip_node_t.h"
+
+// Most levels a node can have: enough for 2^SKIP_MAX_LEVEL elements
+#ifndef SKIP_MAX_LEVEL
+#define SKIP_MAX_LEVEL 24
+#endif
+
+
+
+// Sorted singly linked list with express lanes (Pugh's skip list).
+// Every node is on level 0, and on each level above with probability
+// 1/2, so level l links about one node in 2^l. A search runs along the
+// top level and drops a level whenever the next node would overshoot:
+// expected O(log n) for search, insert and erase, with no rebalancing.
+//
+// Elements are ordered by 'Less' and are unique by it: inserting an
+// element equivalent to one in the list replaces its data. Level 0 is an
+// ordinary sll_t-like chain from get_head(), for scans in order.
+template <class T, class Less = std::less<T> > class skip_list_t
+{
+ public:
+    // constructor
+    skip_list_t(const unsigned long long seed = 0x9E3779B97F4A7C15ULL);
+
+    // destructor
+    ~skip_list_t(void);
+
+    // getters
+    skip_node_t<T>* get_head(void) const { return head_->get_next(0); };
+    int get_size(void) const { return size_; };
+
+    bool empty(void) const;
+
+    // operations
+    void clear(void);
+    skip_node_t<T>* insert(const T&);   // the node now holding the data
+    void push_back(const T&);           // for data after all the others
+    bool erase(const T&);
+
+    skip_node_t<T>* search(const T&) const;
+
+    // I/O
+    std::ostream& write(std::ostream& = std::cout) const;
+
+ private:
+    skip_node_t<T>* head_;                   // sentinel with every level
+    skip_node_t<T>* last_[SKIP_MAX_LEVEL];   // last node of every level
+    int levels_;                             // levels in use
+    int size_;
+    unsigned long long state_;               // random levels
+    Less less_;
+
+    int random_level(void);
+    skip_node_t<T>* find(const T&, skip_node_t<T>**) const;
+
+    skip_list_t(const skip_list_t<T, Less>&);  // not copyable
+};
+
+
+
+// constructor
+template <class T, class Less>
+skip_list_t<T, Less>::skip_list_t(const unsigned long long seed)
+    : head_(new (SKIP_MAX_LEVEL) skip_node_t<T>(SKIP_MAX_LEVEL)),
+      levels_(1), size_(0), state_(seed != 0 ? seed : 1), less_()
+{
+    for (int l{0}; l < SKIP_MAX_LEVEL; l++)
+        last_[l] = head_;
+}
+
+
+
+// destructor
+template <class T, class Less>
+skip_list_t<T, Less>::~skip_list_t(void)
+{
+    clear();
+    delete head_;
+}
+
+
+
+template <class T, class Less> bool
+skip_list_t<T, Less>::empty(void) const
+{
+    return size_ == 0;
+}
+
+
+
+// 1 + the trailing zero bits of a xorshift64 draw: level l with
+// probability 2^-l
+template <class T, class Less> int
+skip_list_t<T, Less>::random_level(void)
+{
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 7;
+    state_ ^= state_ << 17;
+
+    int level{1};
+    for (unsigned long long r{state_}; (r & 1) && level < SKIP_MAX_LEVEL; r >>= 1)
+        level++;
+
+    return level;
+}
+
+
+
+// Last node before d on every level (in 'update', if not NULL), and the
+// node after it on level 0
+template <class T, class Less> skip_node_t<T>*
+skip_list_t<T, Less>::find(const T& d, skip_node_t<T>** update) const
+{
+    skip_node_t<T>* aux{head_};
+
+    for (int l{levels_ - 1}; l >= 0; l--)
+    {
+        skip_node_t<T>* next{aux->get_next(l)};
+        while (next != NULL && less_(next->get_data(), d))
+        {
+            aux = next;
+            next = aux->get_next(l);
+        }
+
+        if (update != NULL)
+            update[l] = aux;
+    }
+
+    return aux->get_next(0);
+}
+
+// -- OPERATIONS --
+
+template <class T, class Less> void
+skip_list_t<T, Less>::clear(void)
+{
+    skip_node_t<T>* aux{head_->get_next(0)};
+    while (aux != NULL)
+    {
+        skip_node_t<T>* next{aux->get_next(0)};
+        delete aux;
+        aux = next;
+    }
+
+    for (int l{0}; l < SKIP_MAX_LEVEL; l++)
+    {
+        head_->set_next(l, NULL);
+        last_[l] = head_;
+    }
+    levels_ = 1;
+    size_ = 0;
+}
+
+
+
+template <class T, class Less> skip_node_t<T>*
+skip_list_t<T, Less>::insert(const T& d)
+{
+    skip_node_t<T>* update[SKIP_MAX_LEVEL];
+    skip_node_t<T>* n{find(d, update)};
+
+    if (n != NULL && !less_(d, n->get_data()))  // already there
+    {
+        n->set_data(d);
+        return n;
+    }
+
+    const int level{random_level()};
+    for (int l{levels_}; l < level; l++)
+        update[l] = head_;
+    if (level > levels_)
+        levels_ = level;
+
+    n = new (level) skip_node_t<T>(d, level);
+    for (int l{0}; l < level; l++)
+    {
+        n->set_next(l, update[l]->get_next(l));
+        update[l]->set_next(l, n);
+        if (last_[l] == update[l])
+            last_[l] = n;
+    }
+    size_++;
+
+    return n;
+}
+
+
+
+// Ordered construction in O(1) expected per element: the new node only
+// needs linking after the last node of each of its levels
+template <class T, class Less> void
+skip_list_t<T, Less>::push_back(const T& d)
+{
+    assert(empty() || less_(last_[0]->get_data(), d));
+
+    const int level{random_level()};
+    if (level > levels_)
+        levels_ = level;
+
+    skip_node_t<T>* n = new (level) skip_node_t<T>(d, level);
+    for (int l{0}; l < level; l++)
+    {
+        last_[l]->set_next(l, n);
+        last_[l] = n;
+    }
+    size_++;
+}
+
+
+
+template <class T, class Less> bool
+skip_list_t<T, Less>::erase(const T& d)
+{
+    skip_node_t<T>* update[SKIP_MAX_LEVEL];
+    skip_node_t<T>* n{find(d, update)};
+
+    if (n == NULL || less_(d, n->get_data()))
+        return false;
+
+    for (int l{0}; l < n->get_levels(); l++)
+    {
+        update[l]->set_next(l, n->get_next(l));
+        if (last_[l] == n)
+            last_[l] = update[l];
+    }
+
+    while (levels_ > 1 && head_->get_next(levels_ - 1) == NULL)
+        levels_--;
+
+    delete n;
+    size_--;
+
+    return true;
+}
+
+
+
+template <class T, class Less> skip_node_t<T>*
+skip_list_t<T, Less>::search(const T& d) const
+{
+    skip_node_t<T>* n{find(d, NULL)};
+
+    return (n != NULL && !less_(d, n->get_data())) ? n : NULL;
+}
+
+
+
+// I/O
+template <class T, class Less>
+std::ostream& skip_list_t<T, Less>::write(std::ostream& os) const
+{
+    for (skip_node_t<T>* aux{get_head()}; aux != NULL; aux = aux->get_next(0))
+        aux->write(os);
+
+    return os;
+}
+
+
+
+#endif  // SKIP_LISTT_H_
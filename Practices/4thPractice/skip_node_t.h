@@ -0,0 +1,95 @@
+#ifndef SKIP_NODET_H_
+#define SKIP_NODET_H_
+
+#include <iostream>
+#include <cassert>
+#include <cstddef>  // size_t
+#include <new>      // ::operator new
+
+
+
+// Node of a skip list: an sll_node_t with one next pointer per level.
+// Level 0 links every node in order; each level above skips more of them.
+//
+// The pointers (the node's tower) are stored right after the node, in
+// the same allocation, so a node is one new and one cache miss instead of
+// two. It must be created with its number of levels, for the size:
+//
+//   new (levels) skip_node_t<T>(data, levels)
+template <class T> class alignas(void*) skip_node_t
+{
+ public:
+    // constructors
+    skip_node_t(const int levels) : data_(), levels_(levels) { build(); }
+    skip_node_t(const T& data, const int levels)
+        : data_(data), levels_(levels) { build(); }
+
+    // destructor
+    ~skip_node_t(void) {};
+
+    // memory
+    static void* operator new(size_t size, const int levels)
+    {
+        assert(size == sizeof(skip_node_t<T>) && levels > 0);
+        return ::operator new(size + levels * sizeof(skip_node_t<T>*));
+    }
+    static void operator delete(void* p) { ::operator delete(p); }
+    static void operator delete(void* p, const int) { ::operator delete(p); }
+
+    // getters & setters
+    int get_levels(void) const { return levels_; }
+
+    skip_node_t<T>* get_next(const int l = 0) const
+    {
+        assert(l >= 0 && l < levels_);
+        return tower()[l];
+    }
+    void set_next(const int l, skip_node_t<T>* next)
+    {
+        assert(l >= 0 && l < levels_);
+        tower()[l] = next;
+    }
+
+    const T& get_data(void) const { return data_; }
+    void set_data(const T& data) { data_ = data; }
+
+    // E/S
+    std::ostream& write(std::ostream& = std::cout) const;
+
+ private:
+    T data_;
+    int levels_;
+
+    void build(void);
+    skip_node_t<T>** tower(void) const  // the next pointers, after the node
+    {
+        return reinterpret_cast<skip_node_t<T>**>(const_cast<skip_node_t<T>*>(this) + 1);
+    }
+
+    skip_node_t(const skip_node_t<T>&);  // not copyable
+};
+
+
+
+template <class T> void
+skip_node_t<T>::build(void)
+{
+    assert(levels_ > 0);
+
+    for (int l{0}; l < levels_; l++)
+        tower()[l] = NULL;
+}
+
+
+
+// I/O
+template <class T>
+std::ostream& skip_node_t<T>::write(std::ostream& os) const
+{
+    os << data_;
+    return os;
+}
+
+
+
+#endif  // SKIP_NODET_H_
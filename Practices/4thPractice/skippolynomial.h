@@ -0,0 +1,151 @@
+#ifndef SKIPPOLYNOMIAL_H_
+#define SKIPPOLYNOMIAL_H_
+
+#include <iostream>
+
+#include "sllpolynomial.h"
+#include "skip_list_t.h"
+
+typedef skip_node_t<pair_double_t> SkipPolyNode;
+typedef skip_list_t<pair_double_t, pair_inx_less<double> > skip_poly_list_t;
+
+
+
+// Polynomial kept sorted by exponent in a skip list. It reads like an
+// SllPolynomial (level 0 is the same ascending chain of terms) but a
+// single coefficient can be read, set or added to in expected
+// O(log n) instead of a walk from the head, which is what keeps
+// updates cheap on polynomials with hundreds of thousands of terms.
+class SkipPolynomial : public skip_poly_list_t
+{
+ public:
+    // constructors
+    SkipPolynomial(void) : skip_poly_list_t() {};
+    SkipPolynomial(const vector_t<double>&, const double = EPS);
+
+    // destructor
+    ~SkipPolynomial() {};
+
+    // I/O
+    void Write(std::ostream& = std::cout) const;
+
+    // getters & setters
+    double Get(const int) const;                       // coefficient of x^inx
+    void Set(const int, const double, const double = EPS);
+    void Add(const int, const double, const double = EPS);
+
+    // operations
+    double Eval(const double) const;
+    bool IsEqual(const SkipPolynomial&, const double = EPS) const;
+    void Sum(const SkipPolynomial&, SkipPolynomial&, const double = EPS) const;
+
+    // Extra modification
+    double WeirdSum(const double c, const int i) const;
+};
+
+
+
+// constructor: the exponents come in ascending order, so every term is
+// appended in O(1)
+SkipPolynomial::SkipPolynomial(const vector_t<double>& v, const double eps)
+{
+    for (int i{0}; i < v.get_size(); ++i)
+        if (IsNotZero(v[i], eps))
+            push_back(pair_double_t(v[i], i));
+}
+
+
+
+// I/O
+void
+SkipPolynomial::Write(std::ostream& os) const
+{
+    TermsWrite(os, NodeCursor(get_head()));
+}
+
+
+
+std::ostream&
+operator<<(std::ostream& os, const SkipPolynomial& p) {
+    p.Write(os);
+    return os;
+}
+
+
+
+// -- GETTERS & SETTERS --
+
+double
+SkipPolynomial::Get(const int inx) const
+{
+    SkipPolyNode* n{search(pair_double_t(0.0, inx))};
+    return (n != NULL) ? n->get_data().get_val() : 0.0;
+}
+
+
+
+// Coefficients that are not IsNotZero are not stored: setting one to
+// (about) zero removes the term
+void
+SkipPolynomial::Set(const int inx, const double val, const double eps)
+{
+    assert(inx >= 0);
+
+    if (IsNotZero(val, eps))
+        insert(pair_double_t(val, inx));
+    else
+        erase(pair_double_t(val, inx));
+}
+
+
+
+void
+SkipPolynomial::Add(const int inx, const double val, const double eps)
+{
+    Set(inx, Get(inx) + val, eps);
+}
+
+
+
+// -- OPERATIONS WITH POLYNOMIALS --
+
+// The walks of sllpolynomial_terms.h, on level 0
+double
+SkipPolynomial::Eval(const double x) const {
+    return TermsEval(NodeCursor(get_head()), x);
+}
+
+
+
+bool
+SkipPolynomial::IsEqual(const SkipPolynomial& pol, const double eps) const
+{
+    return TermsIsEqual(NodeCursor(get_head()), NodeCursor(pol.get_head()), eps);
+}
+
+
+
+// Merge of both polynomials into polsum, which must start empty: the
+// terms come out in order, so they are appended with push_back
+void
+SkipPolynomial::Sum(const SkipPolynomial& pol, SkipPolynomial& polsum,
+                    const double eps) const
+{
+    assert(polsum.empty());
+
+    TermsSum(NodeCursor(get_head()), NodeCursor(pol.get_head()),
+             [&polsum](const pair_double_t& t) { polsum.push_back(t); }, eps);
+}
+
+
+
+// Extra modification: same as SllPolynomial::WeirdSum
+double
+SkipPolynomial::WeirdSum(const double c, const int i) const
+{
+    return TermsWeirdSum(NodeCursor(get_head()), c, i);
+}
+
+
+
+#endif  // SKIPPOLYNOMIAL_H_
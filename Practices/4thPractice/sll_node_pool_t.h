@@ -0,0 +1,289 @@
+#ifndef SLL_NODE_POOLT_H_
+#define SLL_NODE_POOLT_H_
+
+#include <cassert>
+#include <cstddef>  // size_t
+#include <mutex>
+#include <new>      // ::operator new
+#include <vector>
+
+// Bytes carved at a time into nodes
+#ifndef SLL_SLAB_BYTES
+#define SLL_SLAB_BYTES (64 * 1024)
+#endif
+
+// Free nodes a thread's cache keeps; past this it gives them all to the
+// global pool
+#ifndef SLL_CACHE_NODES
+#define SLL_CACHE_NODES 16384
+#endif
+
+
+
+template <class T> class sll_node_t;
+
+
+
+// Memory for the nodes of sll_t<T>, carved out of large slabs instead of
+// one new per node. Freed nodes go on a free list threaded through their
+// own next_ pointers, so a whole list can be handed back at once without
+// walking it: release_chain is O(1). Slabs are never returned to the
+// system; they just keep being reused.
+//
+// Every thread has its own cache (free nodes plus the slab it is
+// carving), so allocating and freeing take no lock. A thread whose cache
+// runs dry takes a chain from the global pool before carving a new slab.
+// A thread whose cache grows past SLL_CACHE_NODES free nodes, or that
+// ends, gives them to the global pool. Nodes can be freed by a different
+// thread than the one that allocated them: a thread that only frees
+// (the consumer of lists another thread builds) passes them back to the
+// builder through the global pool, instead of piling them up while the
+// builder carves new slabs.
+template <class T> class sll_node_pool_t
+{
+ public:
+    typedef sll_node_t<T> node_t;
+
+    // operations
+    static void* allocate(void);
+    static void release(void*);                      // one node, already destroyed
+    static void release_chain(node_t*, const long);  // a NULL-terminated list
+                                                     // of them, and its length
+
+    // getters
+    static long get_slabs(void);
+
+ private:
+    struct chain_t
+    {
+        node_t* first_;
+        long size_;
+
+        chain_t(node_t* first, const long size) : first_(first), size_(size) {}
+    };
+
+    struct cache_t
+    {
+        node_t* free_;                   // first chain of free nodes
+        long free_size_;                 // its length
+        std::vector<chain_t> chains_;    // the other chains
+        long size_;                      // free nodes in all of them
+        char* cursor_;                   // rest of the slab being carved
+        char* end_;
+
+        cache_t(void)
+            : free_(NULL), free_size_(0), chains_(), size_(0),
+              cursor_(NULL), end_(NULL) {}
+        ~cache_t(void);
+    };
+
+    struct global_t
+    {
+        std::mutex mutex_;
+        std::vector<chain_t> chains_;
+        std::vector<char*> slabs_;
+    };
+
+    static thread_local bool gone_;  // this thread's cache is destroyed
+
+    static cache_t* cache(void);
+    static global_t& global(void);
+    static void give_back(cache_t&);  // free nodes to the global pool
+    static bool fits(const cache_t& c)  // room for one more node in the slab
+    {
+        return c.end_ - c.cursor_ >= (long)sizeof(node_t);
+    }
+};
+
+
+
+template <class T> thread_local bool sll_node_pool_t<T>::gone_ = false;
+
+
+
+// Per-thread cache, created on first use by each thread. NULL once the
+// thread is being torn down (static lists can still be freeing nodes
+// after the main thread's cache is gone)
+template <class T> typename sll_node_pool_t<T>::cache_t*
+sll_node_pool_t<T>::cache(void)
+{
+    if (gone_)
+        return NULL;
+
+    static thread_local cache_t c;
+    return &c;
+}
+
+
+
+// The global pool is never destroyed, for the same reason
+template <class T> typename sll_node_pool_t<T>::global_t&
+sll_node_pool_t<T>::global(void)
+{
+    static global_t* g = new global_t;
+    return *g;
+}
+
+
+
+// The chains move as they are: one lock, no walk over the nodes
+template <class T> void
+sll_node_pool_t<T>::give_back(cache_t& c)
+{
+    global_t& g = global();
+    std::lock_guard<std::mutex> lock(g.mutex_);
+
+    if (c.free_ != NULL)
+        g.chains_.push_back(chain_t(c.free_, c.free_size_));
+    g.chains_.insert(g.chains_.end(), c.chains_.begin(), c.chains_.end());
+
+    c.free_ = NULL;
+    c.free_size_ = 0;
+    c.chains_.clear();
+    c.size_ = 0;
+}
+
+
+
+// Hands the cache over to the global pool, the unused end of the slab
+// included
+template <class T>
+sll_node_pool_t<T>::cache_t::~cache_t(void)
+{
+    gone_ = true;
+
+    node_t* rest{NULL};
+    long count{0};
+    for ( ; fits(*this); cursor_ += sizeof(node_t), count++)
+    {
+        node_t* n = reinterpret_cast<node_t*>(cursor_);
+        n->set_next(rest);
+        rest = n;
+    }
+
+    if (rest != NULL)
+        chains_.push_back(chain_t(rest, count));
+    give_back(*this);
+}
+
+// -- OPERATIONS --
+
+template <class T> void*
+sll_node_pool_t<T>::allocate(void)
+{
+    cache_t* cp = cache();
+    if (cp == NULL)
+        return ::operator new(sizeof(node_t));  // released to the pool all the same
+
+    cache_t& c = *cp;
+
+    if (c.free_ == NULL && !c.chains_.empty())
+    {
+        c.free_ = c.chains_.back().first_;
+        c.free_size_ = c.chains_.back().size_;
+        c.chains_.pop_back();
+    }
+
+    if (c.free_ == NULL && !fits(c))
+    {
+        global_t& g = global();
+        std::lock_guard<std::mutex> lock(g.mutex_);
+
+        if (!g.chains_.empty())
+        {
+            c.free_ = g.chains_.back().first_;
+            c.free_size_ = g.chains_.back().size_;
+            c.size_ += c.free_size_;
+            g.chains_.pop_back();
+        }
+        else
+        {
+            c.cursor_ = static_cast<char*>(::operator new(SLL_SLAB_BYTES));
+            c.end_ = c.cursor_ + SLL_SLAB_BYTES;
+            g.slabs_.push_back(c.cursor_);
+        }
+    }
+
+    if (c.free_ != NULL)
+    {
+        node_t* n = c.free_;
+        c.free_ = n->get_next();
+        c.free_size_--;
+        c.size_--;
+        return n;
+    }
+
+    void* p = c.cursor_;
+    c.cursor_ += sizeof(node_t);
+    return p;
+}
+
+
+
+template <class T> void
+sll_node_pool_t<T>::release(void* p)
+{
+    if (p == NULL)
+        return;
+
+    node_t* n = static_cast<node_t*>(p);
+    cache_t* c = cache();
+
+    if (c == NULL)
+    {
+        n->set_next(NULL);
+        release_chain(n, 1);
+        return;
+    }
+
+    n->set_next(c->free_);
+    c->free_ = n;
+    c->free_size_++;
+
+    if (++c->size_ > SLL_CACHE_NODES)
+        give_back(*c);
+}
+
+
+
+// The chain becomes the cache's first chain as it is, whatever its length
+template <class T> void
+sll_node_pool_t<T>::release_chain(node_t* first, const long size)
+{
+    if (first == NULL)
+        return;
+
+    cache_t* c = cache();
+
+    if (c == NULL)
+    {
+        global_t& g = global();
+        std::lock_guard<std::mutex> lock(g.mutex_);
+        g.chains_.push_back(chain_t(first, size));
+        return;
+    }
+
+    if (c->free_ != NULL)
+        c->chains_.push_back(chain_t(c->free_, c->free_size_));
+    c->free_ = first;
+    c->free_size_ = size;
+
+    c->size_ += size;
+    if (c->size_ > SLL_CACHE_NODES)
+        give_back(*c);
+}
+
+
+
+template <class T> long
+sll_node_pool_t<T>::get_slabs(void)
+{
+    global_t& g = global();
+    std::lock_guard<std::mutex> lock(g.mutex_);
+
+    return g.slabs_.size();
+}
+
+
+
+#endif  // SLL_NODE_POOLT_H_
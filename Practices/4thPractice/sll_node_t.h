@@ -2,6 +2,16 @@
 #define SLL_NODET_H_
 
 #include <iostream>
+#include <cassert>
+#include <cstddef>  // size_t
+
+#include "sll_node_pool_t.h"
+
+// Nodes come from sll_node_pool_t instead of one new each. 0 goes back
+// to plain new/delete (e.g. for a memory checker, which the pool blinds)
+#ifndef SLL_NODE_POOL
+#define SLL_NODE_POOL 1
+#endif
 
 
 
@@ -26,6 +36,16 @@ template <class T> class sll_node_t
     // E/S
     std::ostream& write(std::ostream& = std::cout) const;
 
+#if SLL_NODE_POOL
+    // memory
+    static void* operator new(size_t size)
+    {
+        assert(size == sizeof(sll_node_t<T>));
+        return sll_node_pool_t<T>::allocate();
+    }
+    static void operator delete(void* p) { sll_node_pool_t<T>::release(p); }
+#endif
+
  private:
     T data_;
     sll_node_t<T>* next_;
@@ -3,9 +3,13 @@
 
 #include <iostream>
 #include <cassert>
+#include <type_traits>  // std::is_trivially_destructible
 
 #include "sll_node_t.h"
 
+// Bins of sll_t::sort: enough for 2^SLL_SORT_BINS nodes
+#define SLL_SORT_BINS 64
+
 
 
 // Class for a singly linked list
@@ -14,30 +18,53 @@ template <class T> class sll_t
 {
  public:
     // constructor
-    sll_t(void) : head_(NULL) {}
+    sll_t(void) : head_(NULL), tail_(NULL), size_(0) {}
 
     // destructor
     ~sll_t(void);
 
     // getters
     sll_node_t<T>* get_head(void) const { return head_; };
+    sll_node_t<T>* get_tail(void) const { return tail_; };
+    int get_size(void) const { return size_; };
   
     bool empty(void) const;
 
     // operations
+    void clear(void);  // frees every node
     void push_front(sll_node_t<T>*);
+    void push_back(sll_node_t<T>*);
     sll_node_t<T>* pop_front(void);
+    void splice(sll_t<T>&);  // moves all its nodes to the end of this one
 
     void insert_after(sll_node_t<T>*, sll_node_t<T>*);
     sll_node_t<T>* erase_after(sll_node_t<T>*);
 
     sll_node_t<T>* search(const T&) const;
 
+    // stable sort by 'less', relinking the nodes; with 'combine', equal
+    // elements are merged into one (see below)
+    template <class Less> void sort(Less);
+    template <class Less, class Combine> void sort(Less, Combine);
+
     // I/O
     std::ostream& write(std::ostream& = std::cout) const;
 
  private:
     sll_node_t<T>* head_;
+    sll_node_t<T>* tail_;  // last node, NULL when empty
+    int size_;
+
+    template <class Less, class Combine>
+    sll_node_t<T>* merge(sll_node_t<T>*, sll_node_t<T>*, Less, Combine, sll_node_t<T>**);
+};
+
+
+
+// Combine for sort that never merges anything
+template <class T> struct sll_keep_all
+{
+    bool operator()(T&, const T&) const { return false; }
 };
 
 
@@ -46,12 +73,7 @@ template <class T> class sll_t
 template <class T>
 sll_t<T>::~sll_t(void)
 {
-    while (!empty())
-    {
-        sll_node_t<T>* aux = head_;
-        head_ = head_->get_next();
-        delete aux;
-    }
+    clear();
 }
 
 
@@ -65,6 +87,35 @@ sll_t<T>::empty(void) const
 
 // -- OPERATIONS --
 
+// With the node pool and data that needs no destructor, the nodes are
+// handed back as the chain they already form: O(1) whatever the length.
+// Otherwise they are deleted one by one
+template <class T> void
+sll_t<T>::clear(void)
+{
+#if SLL_NODE_POOL
+    if (std::is_trivially_destructible<T>::value)
+    {
+        sll_node_pool_t<T>::release_chain(head_, size_);
+        head_ = tail_ = NULL;
+        size_ = 0;
+        return;
+    }
+#endif
+
+    while (!empty())
+    {
+        sll_node_t<T>* aux = head_;
+        head_ = head_->get_next();
+        delete aux;
+    }
+    tail_ = NULL;
+    size_ = 0;
+}
+
+
+
+
 template <class T> void
 sll_t<T>::push_front(sll_node_t<T>* n)
 {
@@ -72,6 +123,25 @@ sll_t<T>::push_front(sll_node_t<T>* n)
 
     n->set_next(head_);
     head_ = n;
+    if (tail_ == NULL)
+        tail_ = n;
+    size_++;
+}
+
+
+
+template <class T> void
+sll_t<T>::push_back(sll_node_t<T>* n)
+{
+    assert(n != NULL);
+
+    n->set_next(NULL);
+    if (tail_ == NULL)
+        head_ = n;
+    else
+        tail_->set_next(n);
+    tail_ = n;
+    size_++;
 }
 
 
@@ -83,12 +153,37 @@ sll_t<T>::pop_front(void)
     sll_node_t<T>* aux = head_;
     head_ = head_->get_next();
     aux->set_next(NULL);
+    if (head_ == NULL)
+        tail_ = NULL;
+    size_--;
 
     return aux;
 }
 
 
 
+// O(1): the other list's chain is linked after the tail as it is
+template <class T> void
+sll_t<T>::splice(sll_t<T>& l)
+{
+    assert(&l != this);
+
+    if (l.empty())
+        return;
+
+    if (tail_ == NULL)
+        head_ = l.head_;
+    else
+        tail_->set_next(l.head_);
+    tail_ = l.tail_;
+    size_ += l.size_;
+
+    l.head_ = l.tail_ = NULL;
+    l.size_ = 0;
+}
+
+
+
 template <class T> void
 sll_t<T>::insert_after(sll_node_t<T>* prev, sll_node_t<T>* n)
 {
@@ -96,6 +191,9 @@ sll_t<T>::insert_after(sll_node_t<T>* prev, sll_node_t<T>* n)
 
     n->set_next(prev->get_next());
     prev->set_next(n);
+    if (prev == tail_)
+        tail_ = n;
+    size_++;
 }
 
 
@@ -110,6 +208,9 @@ sll_node_t<T>* sll_t<T>::erase_after(sll_node_t<T>* prev)
     assert(aux != NULL);
     prev->set_next(aux->get_next());
     aux->set_next(NULL);
+    if (aux == tail_)
+        tail_ = prev;
+    size_--;
 
     return aux;
 }
@@ -127,6 +228,131 @@ sll_t<T>::search(const T& d) const
     return aux;
 }
 
+template <class T> template <class Less> void
+sll_t<T>::sort(Less less)
+{
+    sort(less, sll_keep_all<T>());
+}
+
+
+
+// Bottom-up merge sort, in one pass over the list: nodes are taken one
+// by one and bins[k] holds a sorted list made of 2^k merges, which is
+// carried into bins[k + 1] (binary addition) when the next one comes.
+// O(n log n) comparisons and O(1) extra memory (the bins), with no
+// recursion and no data copied: only next pointers change, so big
+// elements cost the same as small ones. Merges work on lists that were
+// just touched, which keeps it cache friendly compared with passes over
+// the whole list. Earlier elements win ties, so it is stable.
+//
+// combine(a, b) is called for equal elements a (earlier) and b when two
+// lists are merged; if it returns true, b has been merged into a and its
+// node is freed, so each group of equal elements ends up as one node
+// (e.g. the terms of an exponent added up) and the merges after shrink
+template <class T> template <class Less, class Combine> void
+sll_t<T>::sort(Less less, Combine combine)
+{
+    sll_node_t<T>* bins[SLL_SORT_BINS];
+    int used{0};
+
+    while (head_ != NULL)
+    {
+        sll_node_t<T>* run{head_};
+        head_ = head_->get_next();
+        run->set_next(NULL);
+
+        int k{0};
+        for ( ; k < used && bins[k] != NULL; k++)
+        {
+            run = merge(bins[k], run, less, combine, NULL);
+            bins[k] = NULL;
+        }
+
+        if (k == used)
+            used++;
+        assert(used <= SLL_SORT_BINS);
+        bins[k] = run;
+    }
+
+    // bins above hold earlier elements
+    tail_ = NULL;
+    for (int k{0}; k < used; k++)
+        if (bins[k] != NULL)
+            head_ = (head_ == NULL) ? bins[k] :
+                    merge(bins[k], head_, less, combine, (k == used - 1) ? &tail_ : NULL);
+
+    if (tail_ == NULL)
+        for (tail_ = head_; tail_ != NULL && tail_->get_next() != NULL; )
+            tail_ = tail_->get_next();
+}
+
+
+
+// Merges the sorted lists a (earlier elements) and b and returns the
+// head; the last node goes to *last, if not NULL
+template <class T> template <class Less, class Combine> sll_node_t<T>*
+sll_t<T>::merge(sll_node_t<T>* a, sll_node_t<T>* b, Less less, Combine combine,
+                sll_node_t<T>** last)
+{
+    sll_node_t<T>* head{NULL};
+    sll_node_t<T>* tail{NULL};
+
+    while (a != NULL && b != NULL)
+    {
+        sll_node_t<T>* e;
+
+        if (less(b->get_data(), a->get_data()))
+        {
+            e = b;
+            b = b->get_next();
+        }
+        else
+        {
+            if (!less(a->get_data(), b->get_data()))
+            {
+                T data{a->get_data()};
+                if (combine(data, b->get_data()))
+                {
+                    a->set_data(data);
+                    sll_node_t<T>* aux{b};
+                    b = b->get_next();
+                    delete aux;
+                    size_--;
+                    continue;
+                }
+            }
+
+            e = a;
+            a = a->get_next();
+        }
+
+        if (tail == NULL)
+            head = e;
+        else
+            tail->set_next(e);
+        tail = e;
+    }
+
+    sll_node_t<T>* rest{(a != NULL) ? a : b};
+    if (tail == NULL)
+        head = rest;
+    else
+        tail->set_next(rest);
+
+    if (last != NULL)
+    {
+        if (rest != NULL)
+            tail = rest;
+        while (tail != NULL && tail->get_next() != NULL)
+            tail = tail->get_next();
+        *last = tail;
+    }
+
+    return head;
+}
+
+
+
 // I/O
 template <class T>
 std::ostream& sll_t<T>::write(std::ostream& os) const
@@ -2,11 +2,17 @@
 #define SLLPOLYNOMIAL_H_
 
 #include <iostream>
-#include <math.h>  // fabs, pow
+#include <math.h>  // fabs
+#include <queue>   // std::priority_queue
+#include <vector>
+#include <functional>  // std::greater
+#include <algorithm>   // std::make_heap, std::push_heap, std::pop_heap
 
 #include "pair_t.h"
 #include "sll_t.h"
 #include "vector_t.h"
+#include "power_table_t.h"
+#include "sllpolynomial_terms.h"
 
 #define EPS 1.0e-6
 
@@ -31,8 +37,12 @@ class SllPolynomial : public sll_t<pair_double_t>
   
     // operations
     double Eval(const double) const;
+    double Eval(const power_table_t&) const;  // x^(2^k) shared across calls
     bool IsEqual(const SllPolynomial&, const double = EPS) const;
     void Sum(const SllPolynomial&, SllPolynomial&, const double = EPS);
+    void SumInto(SllPolynomial&, const double = EPS);  // empties the other
+    void Sort(const double = EPS);  // ascending exponents, one term each
+    void Multiply(const SllPolynomial&, SllPolynomial&, const double = EPS) const;
 
     // Extra modification
     double WeirdSum(const double c, const int i) const;
@@ -49,18 +59,19 @@ IsNotZero(const double val, const double eps = EPS)
 
 
 // constructor
+// The terms are appended in ascending exponent order, in a single pass
 SllPolynomial::SllPolynomial(const vector_t<double>& v, const double eps)
 {
     // If we use size_t, we will get this warning:
 
     // warning: narrowing conversion of ‘(& v)->vector_t<double>::get_size()’
     // from ‘int’ to ‘size_t’ {aka ‘long unsigned int’} [-Wnarrowing]
-    for (int i{v.get_size() - 1}; i >= 0; --i)
+    for (int i{0}; i < v.get_size(); ++i)
     {
         if (IsNotZero(v[i], eps))
         {
             SllPolyNode* node = new SllPolyNode(pair_double_t(v[i], i));
-            sll_t<pair_double_t>::push_front(node);
+            sll_t<pair_double_t>::push_back(node);
         }
     }
 }
@@ -71,31 +82,7 @@ SllPolynomial::SllPolynomial(const vector_t<double>& v, const double eps)
 void
 SllPolynomial::Write(std::ostream& os) const
 {
-    os << "[ ";
-    bool first{true};
-
-    SllPolyNode* aux{get_head()};
-
-    while (aux != NULL)
-    {
-        int inx{aux->get_data().get_inx()};
-        double val{aux->get_data().get_val()};
-    
-        if (val > 0)
-            os << (!first ? " + " : "") << val;
-        else
-            os << (!first ? " - " : "-") << fabs(val);
-
-        os << (inx > 1 ? " x^" : (inx == 1) ? " x" : "");
-    
-        if (inx > 1)
-            os << inx;
-    
-        first = false;
-        aux = aux->get_next();
-    }
-    
-    os << " ]" << std::endl;
+    TermsWrite(os, NodeCursor(get_head()));
 }
 
 
@@ -111,154 +98,264 @@ operator<<(std::ostream& os, const SllPolynomial& p) {
 // -- OPERATIONS WITH POLYNOMIALS --
 
 // NOTE: Tested, works fine.
+// The running power of TermsEval (see power_anchor_t)
 double
 SllPolynomial::Eval(const double x) const {
-    double result{0.0};
-    SllPolyNode* aux{get_head()};
+    return TermsEval(NodeCursor(get_head()), x);
+}
 
-    while (aux != NULL)
-    {
-        int inx{aux->get_data().get_inx()};
-        double val{aux->get_data().get_val()};
 
-        result += val * pow(x, inx);
 
-        aux = aux->get_next();
-    }
-  
-    return result;
+// Same walk, with the powers taken from a table built once for x
+double
+SllPolynomial::Eval(const power_table_t& pt) const {
+    return TermsEval(NodeCursor(get_head()), pt);
 }
 
 
 
-// Compare two polynomials
+// Compare two polynomials, merged by exponent (ascending, as the
+// constructor builds them): see TermsIsEqual
 bool
 SllPolynomial::IsEqual(const SllPolynomial& sllpol, const double eps) const
 {
-    bool differents = false;
-    
-    SllPolyNode* aux1{get_head()};
-    SllPolyNode* aux2{sllpol.get_head()};
+    return TermsIsEqual(NodeCursor(get_head()), NodeCursor(sllpol.get_head()), eps);
+}
+
 
-    while (aux1 != NULL && aux2 != NULL)
-    {
-        // Let's get the exponents
-        int inx1{aux1->get_data().get_inx()};
-        int inx2{aux2->get_data().get_inx()};
-
-        if (inx1 != inx2)
-            return differents;
-        
-        // Now let's check the coefficients
-        double val1{aux1->get_data().get_val()};
-        double val2{aux2->get_data().get_val()};
-
-        if (fabs(val1 - val2) > eps)
-            return differents;
-
-        // Let's move to the next one
-        aux1 = aux1->get_next();
-        aux2 = aux2->get_next();
-    }
 
-    return !differents;
+// Generate a new polynomial that is the sum of two polynomials.
+// A merge of both lists by exponent: the terms are appended to
+// sllpolsum in ascending order, as the constructor builds them
+void
+SllPolynomial::Sum(const SllPolynomial& sllpol, SllPolynomial& sllpolsum, const double eps)
+{
+    TermsSum(NodeCursor(get_head()), NodeCursor(sllpol.get_head()),
+             [&sllpolsum](const pair_double_t& t) { sllpolsum.push_back(new SllPolyNode(t)); },
+             eps);
 }
 
 
 
-// Generate a new polynomial that is the sum of two polynomials
+// this += sllpol without allocating: the nodes of both lists are
+// relinked in exponent order (both must be ascending), a term present
+// in both keeps this one's node with the sum, and nodes whose sum
+// cancels are freed. sllpol is left empty
 void
-SllPolynomial::Sum(const SllPolynomial& sllpol, SllPolynomial& sllpolsum, const double eps)
+SllPolynomial::SumInto(SllPolynomial& sllpol, const double eps)
 {
-    SllPolyNode* aux1{get_head()};
-    SllPolyNode* aux2{sllpol.get_head()};
-    SllPolyNode* nodeSum{};
+    assert(&sllpol != this);
 
-    while (aux1 != nullptr && aux2 != nullptr)
-    {
-        int inx1{aux1->get_data().get_inx()};
-        int inx2{aux2->get_data().get_inx()};
+    SllPolynomial result;
 
-        double val1{aux1->get_data().get_val()};
-        double val2{aux2->get_data().get_val()};
+    while (!empty() || !sllpol.empty())
+    {
+        int inx1{!empty() ? get_head()->get_data().get_inx() : -1};
+        int inx2{!sllpol.empty() ? sllpol.get_head()->get_data().get_inx() : -1};
 
-        if (inx1 == inx2)
+        if (inx2 < 0 || (inx1 >= 0 && inx1 < inx2))
+            result.push_back(pop_front());
+        else if (inx1 < 0 || inx2 < inx1)
+            result.push_back(sllpol.pop_front());
+        else
         {
-            double sumVal = val1 + val2;
-            if (fabs(sumVal) > eps)
+            SllPolyNode* node{pop_front()};
+            SllPolyNode* other{sllpol.pop_front()};
+            double val{node->get_data().get_val() + other->get_data().get_val()};
+            delete other;
+
+            if (IsNotZero(val, eps))
             {
-                nodeSum = new SllPolyNode(pair_double_t(sumVal, inx1));
-                sllpolsum.push_front(nodeSum);
+                node->set_data(pair_double_t(val, inx1));
+                result.push_back(node);
             }
-            aux1 = aux1->get_next();
-            aux2 = aux2->get_next();
+            else
+                delete node;
         }
-        else if (inx1 > inx2)
+    }
+
+    splice(result);
+}
+
+
+
+// Sum of n polynomials into sum (which must start empty), consuming
+// them: a k-way merge of their nodes with a min-heap on the exponents
+// at their heads, O(N log n) for N terms in all. Each node is relinked
+// or freed; the only allocation is the heap of n entries. Terms with
+// the same exponent are added up in the first of their nodes, which is
+// only appended once the next exponent shows up, so a sum that cancels
+// is simply freed
+void
+SumMany(SllPolynomial* pols[], const int n, SllPolynomial& sum,
+        const double eps = EPS)
+{
+    assert(sum.empty());
+
+    // min-heap by hand on a vector of n entries, allocated once
+    typedef std::pair<int, int> head_t;  // exponent at the head, polynomial
+    const std::greater<head_t> later;
+    std::vector<head_t> heap;
+    heap.reserve(n);
+
+    for (int k{0}; k < n; k++)
+        if (!pols[k]->empty())
+            heap.push_back(head_t(pols[k]->get_head()->get_data().get_inx(), k));
+    std::make_heap(heap.begin(), heap.end(), later);
+
+    SllPolyNode* acc{NULL};  // term being added up
+
+    while (!heap.empty())
+    {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        const int k{heap.back().second};
+        heap.pop_back();
+
+        SllPolyNode* node{pols[k]->pop_front()};
+        if (!pols[k]->empty())
         {
-            nodeSum = new SllPolyNode(pair_double_t(val2, inx2));
-            sllpolsum.push_front(nodeSum);
-            aux2 = aux2->get_next();
+            heap.push_back(head_t(pols[k]->get_head()->get_data().get_inx(), k));
+            std::push_heap(heap.begin(), heap.end(), later);
         }
-        else  // inx1 < inx2
+
+        const int inx{node->get_data().get_inx()};
+        if (acc != NULL && acc->get_data().get_inx() == inx)
         {
-            nodeSum = new SllPolyNode(pair_double_t(val1, inx1));
-            sllpolsum.push_front(nodeSum);
-            aux1 = aux1->get_next();
+            acc->set_data(pair_double_t(acc->get_data().get_val() +
+                                        node->get_data().get_val(), inx));
+            delete node;
+            continue;
         }
-    }
 
-    // **Append** the remaining nodes from aux1
-    while (aux1 != nullptr)
-    {
-        int inx1{aux1->get_data().get_inx()};
-        double val1{aux1->get_data().get_val()};
-        nodeSum = new SllPolyNode(pair_double_t(val1, inx1));
-        sllpolsum.push_front(nodeSum);
-        aux1 = aux1->get_next();
+        if (acc != NULL)
+        {
+            if (IsNotZero(acc->get_data().get_val(), eps))
+                sum.push_back(acc);
+            else
+                delete acc;
+        }
+        acc = node;
     }
 
-    // **Append** the remaining nodes from aux2
-    while (aux2 != nullptr)
+    if (acc != NULL)
     {
-        int inx2{aux2->get_data().get_inx()};
-        double val2{aux2->get_data().get_val()};
-        nodeSum = new SllPolyNode(pair_double_t(val2, inx2));
-        sllpolsum.push_front(nodeSum);
-        aux2 = aux2->get_next();
+        if (IsNotZero(acc->get_data().get_val(), eps))
+            sum.push_back(acc);
+        else
+            delete acc;
     }
 }
 
 
 
-// Extra modification
-// This function is similar to the Eval function, but
-// it only sums the monomials with a coefficient greater than c
-// and an exponent less than or equal to i
-double  SllPolynomial::WeirdSum(const double c, const int i) const
+// Puts terms that came in any order (e.g. pushed by several producers)
+// in the ascending exponent order the other operations expect: the
+// list's merge sort, adding up the terms with the same exponent on the
+// way, and then a pass that frees the sums that cancelled
+void
+SllPolynomial::Sort(const double eps)
 {
-    double result{0.0};
-    SllPolyNode* aux{get_head()};
+    sort(pair_inx_less<double>(), pair_val_add<double>());
 
-    while (aux != NULL)
-    {
-        int inx {aux->get_data().get_inx()};
-        double val{aux->get_data().get_val()};
+    while (!empty() && !IsNotZero(get_head()->get_data().get_val(), eps))
+        delete pop_front();
+
+    for (SllPolyNode* aux{get_head()}; aux != NULL && aux->get_next() != NULL; )
+        if (!IsNotZero(aux->get_next()->get_data().get_val(), eps))
+            delete erase_after(aux);
+        else
+            aux = aux->get_next();
+}
+
+
+
+// Heap entry of the product: node s of the shorter polynomial times
+// node l of the longer one, keyed by the exponent of that product
+struct SllProductTerm
+{
+    int inx;
+    SllPolyNode* s;
+    SllPolyNode* l;
+
+    // std::priority_queue is a max-heap: reversed to pop the smallest
+    bool operator<(const SllProductTerm& t) const { return inx > t.inx; }
+};
+
+
+
+// Product of two polynomials (Johnson's algorithm). Each term of the
+// shorter polynomial walks the longer one, giving a stream of products
+// with growing exponents; a heap with the head of every stream pops them
+// in increasing exponent order, so equal exponents come out together and
+// the result is appended already sorted, with no dense buffer.
+// O(nz1 × nz2 × log(min(nz1, nz2))). Both lists must be in ascending
+// exponent order (as the vector constructor builds them) and sllpolprod
+// must start empty. Sums under eps are dropped.
+void
+SllPolynomial::Multiply(const SllPolynomial& sllpol, SllPolynomial& sllpolprod,
+                        const double eps) const
+{
+    assert(sllpolprod.empty());
 
-        if (inx <= i && val > c)
+    // Check the order (the loops are empty without asserts)
+    for (SllPolyNode* aux{get_head()}; aux != NULL; aux = aux->get_next())
+        assert(aux->get_next() == NULL ||
+               aux->get_data().get_inx() < aux->get_next()->get_data().get_inx());
+    for (SllPolyNode* aux{sllpol.get_head()}; aux != NULL; aux = aux->get_next())
+        assert(aux->get_next() == NULL ||
+               aux->get_data().get_inx() < aux->get_next()->get_data().get_inx());
+
+    const int n1{get_size()}, n2{sllpol.get_size()};
+
+    const SllPolynomial& shorter = (n1 <= n2) ? *this : sllpol;
+    const SllPolynomial& longer = (n1 <= n2) ? sllpol : *this;
+
+    std::priority_queue<SllProductTerm> heap;
+
+    if (!longer.empty())
+        for (SllPolyNode* aux{shorter.get_head()}; aux != NULL; aux = aux->get_next())
         {
-            result += val;
-            // Could be another way to do it, depends on the criteria 
-            //result += pow(val, inx);
+            SllProductTerm t = { aux->get_data().get_inx() +
+                                 longer.get_head()->get_data().get_inx(),
+                                 aux, longer.get_head() };
+            heap.push(t);
         }
-        else if (inx > i)
+
+    while (!heap.empty())
+    {
+        const int inx{heap.top().inx};
+        double sum{0.0};
+
+        // Every stream whose head has this exponent
+        while (!heap.empty() && heap.top().inx == inx)
         {
-            break;
+            SllProductTerm t = heap.top();
+            heap.pop();
+
+            sum += t.s->get_data().get_val() * t.l->get_data().get_val();
+
+            t.l = t.l->get_next();
+            if (t.l != NULL)
+            {
+                t.inx = t.s->get_data().get_inx() + t.l->get_data().get_inx();
+                heap.push(t);
+            }
         }
 
-        aux = aux->get_next();
+        if (IsNotZero(sum, eps))
+            sllpolprod.push_back(new SllPolyNode(pair_double_t(sum, inx)));
     }
+}
+
 
-    return result;
+
+// Extra modification
+// This function is similar to the Eval function, but
+// it only sums the monomials with a coefficient greater than c
+// and an exponent less than or equal to i
+double  SllPolynomial::WeirdSum(const double c, const int i) const
+{
+    return TermsWeirdSum(NodeCursor(get_head()), c, i);
 }
 
 
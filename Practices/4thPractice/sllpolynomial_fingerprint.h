@@ -0,0 +1,224 @@
+#ifndef SLLPOLYNOMIAL_FINGERPRINT_H_
+#define SLLPOLYNOMIAL_FINGERPRINT_H_
+
+#include <cassert>
+#include <cstring>  // memcpy
+#include <random>
+#include <vector>
+#include <unordered_map>
+#include <math.h>   // fabs, nearbyint
+
+#include "sllpolynomial.h"
+
+
+
+// Fingerprints are polynomials evaluated modulo the Mersenne prime
+// 2^61 - 1, where the reduction after a product is a shift and an add
+#define MERSENNE61 ((1ULL << 61) - 1)
+
+typedef unsigned long long fingerprint_t;
+
+
+
+inline fingerprint_t
+AddMod61(const fingerprint_t a, const fingerprint_t b)
+{
+    fingerprint_t s{a + b};  // < 2^62, no overflow
+    return (s >= MERSENNE61) ? s - MERSENNE61 : s;
+}
+
+
+
+inline fingerprint_t
+MulMod61(const fingerprint_t a, const fingerprint_t b)
+{
+    unsigned __int128 p{(unsigned __int128)a * b};
+    fingerprint_t s{(fingerprint_t)(p & MERSENNE61) + (fingerprint_t)(p >> 61)};
+    return (s >= MERSENNE61) ? s - MERSENNE61 : s;
+}
+
+
+
+inline fingerprint_t
+PowMod61(fingerprint_t x, int e)
+{
+    fingerprint_t result{1};
+    for ( ; e > 0; e >>= 1)
+    {
+        if (e & 1)
+            result = MulMod61(result, x);
+        x = MulMod61(x, x);
+    }
+
+    return result;
+}
+
+
+
+// The evaluation point, drawn once per run. Two different polynomials of
+// degree d agree at a random point with probability at most d / 2^61,
+// so fingerprints can only be compared within the same run
+fingerprint_t
+FingerprintPoint(void)
+{
+    static const fingerprint_t r{[]() {
+        std::random_device rd;
+        fingerprint_t x{((fingerprint_t)rd() << 32) ^ rd()};
+        return 2 + x % (MERSENNE61 - 3);
+    }()};
+
+    return r;
+}
+
+
+
+// A coefficient as an integer number of eps, reduced mod 2^61 - 1.
+// Values too large for a long long (|val / eps| >= 4e18) use their bits
+fingerprint_t
+QuantizeMod61(const double val, const double eps)
+{
+    assert(eps > 0.0);
+
+    const double q{nearbyint(val / eps)};
+
+    if (fabs(q) < 4.0e18)
+    {
+        long long k{(long long)q};
+        fingerprint_t m{(fingerprint_t)(k < 0 ? -k : k) % MERSENNE61};
+        return (k < 0 && m != 0) ? MERSENNE61 - m : m;
+    }
+
+    fingerprint_t bits;
+    memcpy(&bits, &q, sizeof(bits));
+    return bits % MERSENNE61;
+}
+
+
+
+// Fingerprint of a polynomial: Σ round(val / eps) r^inx mod 2^61 - 1.
+// Polynomials that round to the same multiples of eps get the same
+// fingerprint, and different ones collide with probability below
+// degree / 2^61. Two coefficients within eps of each other can still
+// round to neighbouring multiples, so different fingerprints do not rule
+// out IsEqual for values that close to a rounding boundary.
+// The power of r is carried from node to node like in Eval, so the
+// terms can come in any order.
+fingerprint_t
+Fingerprint(const SllPolynomial& sllpol, const double eps = EPS)
+{
+    const fingerprint_t r{FingerprintPoint()};
+    fingerprint_t h{0};
+    fingerprint_t power{1};  // r^prev
+    int prev{0};
+    SllPolyNode* aux{sllpol.get_head()};
+
+    while (aux != NULL)
+    {
+        int inx{aux->get_data().get_inx()};
+
+        if (inx < prev)
+            power = PowMod61(r, inx);
+        else
+            power = MulMod61(power, PowMod61(r, inx - prev));
+
+        h = AddMod61(h, MulMod61(QuantizeMod61(aux->get_data().get_val(), eps), power));
+
+        prev = inx;
+        aux = aux->get_next();
+    }
+
+    return h;
+}
+
+
+
+// Hash index over a set of polynomials, to find duplicates. Every
+// polynomial's fingerprint is computed once, on insertion; a lookup
+// hashes the new polynomial once and only runs IsEqual on the entries
+// whose fingerprint matches, which is nearly always the duplicate itself.
+// The index keeps pointers: the polynomials must outlive it.
+//
+// It can miss duplicates. Fingerprint rounds every coefficient to the
+// nearest multiple of eps, so two polynomials IsEqual accepts, with a
+// coefficient on each side of a rounding boundary, get different
+// fingerprints: find then answers -1 and insert adds a second entry.
+// No finite set of neighbouring buckets fixes that (each coefficient can
+// round either way), so exact dedup needs pairwise IsEqual. A miss never
+// merges polynomials that are not equal.
+template <class P> class fingerprint_index_t
+{
+ public:
+    // constructors
+    fingerprint_index_t(const double eps = EPS) : eps_(eps), collisions_(0) {}
+
+    // destructor
+    ~fingerprint_index_t(void) {}
+
+    // getters
+    int get_size(void) const { return pol_.size(); }
+    long get_collisions(void) const { return collisions_; }
+    const P& operator[](const int id) const { return *pol_[id]; }
+    fingerprint_t get_fingerprint(const int id) const { return fp_[id]; }
+
+    // operations
+    int find(const P&) const;  // id of an equal polynomial, or -1 (can miss one)
+    int insert(const P&);      // that id, or the one of the new entry
+
+ private:
+    double eps_;
+    std::vector<const P*> pol_;
+    std::vector<fingerprint_t> fp_;
+    std::unordered_multimap<fingerprint_t, int> ids_;
+    mutable long collisions_;  // equal fingerprints that IsEqual rejected
+
+    int find(const P&, const fingerprint_t) const;
+};
+
+
+
+template <class P> int
+fingerprint_index_t<P>::find(const P& pol, const fingerprint_t fp) const
+{
+    typedef std::unordered_multimap<fingerprint_t, int>::const_iterator iter_t;
+    std::pair<iter_t, iter_t> range{ids_.equal_range(fp)};
+
+    for (iter_t it{range.first}; it != range.second; ++it)
+    {
+        if (pol_[it->second]->IsEqual(pol, eps_))
+            return it->second;
+        collisions_++;
+    }
+
+    return -1;
+}
+
+
+
+template <class P> int
+fingerprint_index_t<P>::find(const P& pol) const
+{
+    return find(pol, Fingerprint(pol, eps_));
+}
+
+
+
+template <class P> int
+fingerprint_index_t<P>::insert(const P& pol)
+{
+    const fingerprint_t fp{Fingerprint(pol, eps_)};
+
+    int id{find(pol, fp)};
+    if (id >= 0)
+        return id;
+
+    id = pol_.size();
+    pol_.push_back(&pol);
+    fp_.push_back(fp);
+    ids_.insert(std::make_pair(fp, id));
+
+    return id;
+}
+
+
+
+#endif  // SLLPOLYNOMIAL_FINGERPRINT_H_
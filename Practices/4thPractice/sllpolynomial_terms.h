@@ -0,0 +1,188 @@
+#ifndef SLLPOLYNOMIAL_TERMS_H_
+#define SLLPOLYNOMIAL_TERMS_H_
+
+#include <iostream>
+#include <math.h>  // fabs
+
+#include "pair_t.h"
+#include "power_table_t.h"
+
+// The operations every polynomial of this practice shares (SllPolynomial
+// and its unrolled, skip list, frozen and persistent forms), written once
+// over a cursor on the terms. A cursor walks them in list order:
+//
+//   valid()              there is a term under it
+//   get_inx(), get_val() its exponent and coefficient
+//   next()               on to the following term
+//
+// node_cursor_t is the cursor of the lists with one term per node and a
+// get_next() (sll_t, level 0 of skip_list_t, persistent_sll_t). The
+// unrolled and frozen polynomials define their own.
+
+
+
+template <class N> class node_cursor_t
+{
+ public:
+    // constructors
+    node_cursor_t(const N* node) : node_(node) {}
+
+    // getters
+    bool valid(void) const { return node_ != NULL; }
+    int get_inx(void) const { return node_->get_data().get_inx(); }
+    double get_val(void) const { return node_->get_data().get_val(); }
+
+    // operations
+    void next(void) { node_ = node_->get_next(); }
+
+ private:
+    const N* node_;
+};
+
+
+
+template <class N> node_cursor_t<N>
+NodeCursor(const N* node)
+{
+    return node_cursor_t<N>(node);
+}
+
+
+
+// I/O: [ 1 - 2 x + 3 x^4 ]
+template <class C> void
+TermsWrite(std::ostream& os, C c)
+{
+    os << "[ ";
+
+    for (bool first{true}; c.valid(); c.next(), first = false)
+    {
+        int inx{c.get_inx()};
+        double val{c.get_val()};
+
+        if (val > 0)
+            os << (!first ? " + " : "") << val;
+        else
+            os << (!first ? " - " : "-") << fabs(val);
+
+        os << (inx > 1 ? " x^" : (inx == 1) ? " x" : "");
+
+        if (inx > 1)
+            os << inx;
+    }
+
+    os << " ]" << std::endl;
+}
+
+
+
+// The power of x is carried from term to term and taken from scratch
+// again where power_anchor_t says (which also covers lists built by hand
+// with push_front, in any order). x is a double or a power_table_t
+template <class C, class X> double
+TermsEval(C c, const X& x)
+{
+    double result{0.0};
+    double power{1.0};
+    power_anchor_t anchor(PowerSpan(x));
+
+    for ( ; c.valid(); c.next())
+    {
+        int inx{c.get_inx()};
+
+        power = anchor.step(inx) ? AnchorPow(x, inx) : power * GapPow(x, anchor.get_gap());
+        result += c.get_val() * power;
+    }
+
+    return result;
+}
+
+
+
+// Both polynomials are merged by exponent (ascending): a term only one of
+// them has must be (close to) zero, so a polynomial is not "equal" to its
+// prefixes
+template <class C1, class C2> bool
+TermsIsEqual(C1 c1, C2 c2, const double eps)
+{
+    while (c1.valid() || c2.valid())
+    {
+        // the exponents (-1 once a polynomial is over)
+        int inx1{c1.valid() ? c1.get_inx() : -1};
+        int inx2{c2.valid() ? c2.get_inx() : -1};
+
+        // the coefficients of the lowest exponent
+        double val1{0.0};
+        double val2{0.0};
+
+        if (inx2 < 0 || (inx1 >= 0 && inx1 <= inx2))
+        {
+            val1 = c1.get_val();
+            c1.next();
+        }
+        if (inx1 < 0 || (inx2 >= 0 && inx2 <= inx1))
+        {
+            val2 = c2.get_val();
+            c2.next();
+        }
+
+        if (fabs(val1 - val2) > eps)
+            return false;
+    }
+
+    return true;
+}
+
+
+
+// Merge of both polynomials by exponent: every term of the sum goes, in
+// ascending order, to append(pair_t<double>). Terms only one of them has
+// are passed as they are, and sums under eps are dropped
+template <class C1, class C2, class A> void
+TermsSum(C1 c1, C2 c2, A append, const double eps)
+{
+    while (c1.valid() || c2.valid())
+    {
+        int inx1{c1.valid() ? c1.get_inx() : -1};
+        int inx2{c2.valid() ? c2.get_inx() : -1};
+
+        double val{0.0};
+        int inx{0};
+
+        if (inx2 < 0 || (inx1 >= 0 && inx1 <= inx2))
+        {
+            val += c1.get_val();
+            inx = inx1;
+            c1.next();
+        }
+        if (inx1 < 0 || (inx2 >= 0 && inx2 <= inx1))
+        {
+            val += c2.get_val();
+            inx = inx2;
+            c2.next();
+        }
+
+        if (inx1 != inx2 || fabs(val) > eps)
+            append(pair_t<double>(val, inx));
+    }
+}
+
+
+
+// Extra modification: the sum of the coefficients greater than c among
+// the terms of exponent up to i
+template <class C> double
+TermsWeirdSum(C c, const double cmin, const int i)
+{
+    double result{0.0};
+
+    for ( ; c.valid() && c.get_inx() <= i; c.next())
+        if (c.get_val() > cmin)
+            result += c.get_val();
+
+    return result;
+}
+
+
+
+#endif  // SLLPOLYNOMIAL_TERMS_H_
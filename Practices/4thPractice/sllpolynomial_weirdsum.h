@@ -0,0 +1,203 @@
+#ifndef SLLPOLYNOMIAL_WEIRDSUM_H_
+#define SLLPOLYNOMIAL_WEIRDSUM_H_
+
+#include <cassert>
+#include <vector>
+#include <utility>     // std::pair
+#include <algorithm>   // std::sort, std::lower_bound, std::upper_bound, std::merge
+#include <functional>  // std::greater
+
+#include "sllpolynomial.h"
+
+// WeirdSum(c, i) is the sum of the coefficients > c among the terms of
+// exponent <= i. In a list in ascending exponent order those terms are a
+// prefix, so each query is "the values > c among the first r terms",
+// with r found by binary search on the exponents. The walk of WeirdSum
+// is O(n) per query; these answer it in O(log n) (batch) or O(log² n)
+// (index). The sums are added in another order, so they can differ from
+// WeirdSum's in the last bits.
+//
+// Both work on any polynomial whose terms can be walked in ascending
+// exponent order from get_head() (SllPolynomial, SkipPolynomial).
+
+
+
+// Exponents and coefficients of the terms, in list order
+template <class P> void
+WeirdSumTerms(const P& pol, std::vector<int>& inx, std::vector<double>& val)
+{
+    inx.clear();
+    val.clear();
+
+    for (auto aux = pol.get_head(); aux != NULL; aux = aux->get_next())
+    {
+        assert(inx.empty() || inx.back() < aux->get_data().get_inx());
+        inx.push_back(aux->get_data().get_inx());
+        val.push_back(aux->get_data().get_val());
+    }
+}
+
+
+
+// Terms with exponent <= i: the prefix that a query sums over
+inline int
+WeirdSumPrefix(const std::vector<int>& inx, const int i)
+{
+    return std::upper_bound(inx.begin(), inx.end(), i) - inx.begin();
+}
+
+
+
+// Offline: out[k] = pol.WeirdSum(c[k], i[k]) for n queries at once, in
+// O((N + n) log N) for N terms. Queries go by decreasing threshold and
+// terms by decreasing value: when a query comes, exactly the terms with
+// value > c have been added to a Fenwick tree indexed by position, and
+// the answer is a prefix sum of it
+template <class P> void
+WeirdSumMany(const P& pol, const double c[], const int i[], double out[],
+             const int n)
+{
+    std::vector<int> inx;
+    std::vector<double> val;
+    WeirdSumTerms(pol, inx, val);
+    const int size{(int)inx.size()};
+
+    typedef std::pair<double, int> key_t;  // value or threshold, position
+    std::vector<key_t> terms(size);
+    for (int t{0}; t < size; t++)
+        terms[t] = key_t(val[t], t);
+    std::sort(terms.begin(), terms.end(), std::greater<key_t>());
+
+    std::vector<key_t> queries(n);
+    for (int k{0}; k < n; k++)
+        queries[k] = key_t(c[k], k);
+    std::sort(queries.begin(), queries.end(), std::greater<key_t>());
+
+    std::vector<double> tree(size + 1, 0.0);  // Fenwick, 1-based
+    int added{0};
+
+    for (int q{0}; q < n; q++)
+    {
+        const int k{queries[q].second};
+
+        for ( ; added < size && terms[added].first > c[k]; added++)
+            for (int p{terms[added].second + 1}; p <= size; p += p & -p)
+                tree[p] += terms[added].first;
+
+        double result{0.0};
+        for (int p{WeirdSumPrefix(inx, i[k])}; p > 0; p -= p & -p)
+            result += tree[p];
+
+        out[k] = result;
+    }
+}
+
+
+
+// Online: a merge sort tree over the terms. Level d cuts them into blocks
+// of 2^d positions and keeps every block sorted by decreasing value, with
+// running sums inside the block. A prefix of r terms is at most one block
+// per level (the set bits of r); in each, a binary search gives how many
+// values are > c and the running sum their total. O(log² N) per query,
+// O(N log N) memory, built in O(N log N). It copies the terms: later
+// changes to the polynomial are not seen
+class weirdsum_index_t
+{
+ public:
+    // constructors
+    template <class P> weirdsum_index_t(const P&);
+
+    // destructor
+    ~weirdsum_index_t(void) {}
+
+    // getters
+    int get_size(void) const { return inx_.size(); }
+
+    // operations
+    double WeirdSum(const double c, const int i) const;
+
+ private:
+    std::vector<int> inx_;                   // exponents, ascending
+    std::vector<std::vector<double> > val_;  // val_[d]: blocks of 2^d, sorted
+    std::vector<std::vector<double> > sum_;  // sum_[d][j]: block start..j
+
+    void build(void);
+};
+
+
+
+// constructor
+template <class P>
+weirdsum_index_t::weirdsum_index_t(const P& pol)
+    : inx_(), val_(1), sum_()
+{
+    WeirdSumTerms(pol, inx_, val_[0]);
+    build();
+}
+
+
+
+// Each level merges pairs of blocks of the one below
+inline void
+weirdsum_index_t::build(void)
+{
+    const int size{get_size()};
+
+    for (int d{0}; (1 << d) < size; d++)
+    {
+        const std::vector<double>& below{val_[d]};
+        std::vector<double> level(size);
+
+        for (int s{0}; s < size; s += 2 << d)
+        {
+            const int mid{std::min(s + (1 << d), size)};
+            const int end{std::min(s + (2 << d), size)};
+            std::merge(below.begin() + s, below.begin() + mid,
+                       below.begin() + mid, below.begin() + end,
+                       level.begin() + s, std::greater<double>());
+        }
+
+        val_.push_back(level);
+    }
+
+    sum_.resize(val_.size());
+    for (int d{0}; d < (int)val_.size(); d++)
+    {
+        sum_[d].resize(size);
+        for (int j{0}; j < size; j++)
+            sum_[d][j] = val_[d][j] + ((j % (1 << d) != 0) ? sum_[d][j - 1] : 0.0);
+    }
+}
+
+
+
+// The blocks of the prefix go from the biggest down, so each starts
+// where the one before ended, at a multiple of its own size
+inline double
+weirdsum_index_t::WeirdSum(const double c, const int i) const
+{
+    const int r{WeirdSumPrefix(inx_, i)};
+    double result{0.0};
+    int start{0};
+
+    for (int d{(int)val_.size() - 1}; d >= 0; d--)
+    {
+        if ((r & (1 << d)) == 0)
+            continue;
+
+        // values > c lead the (decreasing) block
+        std::vector<double>::const_iterator first{val_[d].begin() + start};
+        const int count = std::lower_bound(first, first + (1 << d), c,
+                                           std::greater<double>()) - first;
+        if (count > 0)
+            result += sum_[d][start + count - 1];
+
+        start += 1 << d;
+    }
+
+    return result;
+}
+
+
+
+#endif  // SLLPOLYNOMIAL_WEIRDSUM_H_
@@ -0,0 +1,104 @@
+#ifndef UNROLLED_NODET_H_
+#define UNROLLED_NODET_H_
+
+#include <iostream>
+#include <cassert>
+
+// Elements per node of an unrolled list. 16 pair_t<double> are 256
+// bytes: a few cache lines the prefetcher streams in one go
+#ifndef UNROLLED_CAPACITY
+#define UNROLLED_CAPACITY 16
+#endif
+
+
+
+// Node of an unrolled linked list: up to UNROLLED_CAPACITY elements
+// stored side by side, plus the link to the next node
+template <class T> class unrolled_node_t
+{
+ public:
+    // constructors
+    unrolled_node_t(void) : size_(0), next_(NULL) {}
+
+    // destructor
+    ~unrolled_node_t(void) {};
+
+    // getters & setters
+    unrolled_node_t<T>* get_next(void) const { return next_; }
+    void set_next(unrolled_node_t<T>* next) { next_ = next; }
+
+    int get_size(void) const { return size_; }
+    bool full(void) const { return size_ == UNROLLED_CAPACITY; }
+
+    const T& get_data(const int i) const { assert(i >= 0 && i < size_); return data_[i]; }
+    void set_data(const int i, const T& data) { assert(i >= 0 && i < size_); data_[i] = data; }
+
+    // operations
+    void insert(const int, const T&);  // at position i, shifting the rest
+    T erase(const int);
+    void move_tail(const int, unrolled_node_t<T>*);  // [i, size) to an empty node
+
+    // E/S
+    std::ostream& write(std::ostream& = std::cout) const;
+
+ private:
+    T data_[UNROLLED_CAPACITY];
+    int size_;
+    unrolled_node_t<T>* next_;
+};
+
+
+
+template <class T> void
+unrolled_node_t<T>::insert(const int i, const T& data)
+{
+    assert(!full() && i >= 0 && i <= size_);
+
+    for (int k{size_}; k > i; k--)
+        data_[k] = data_[k - 1];
+    data_[i] = data;
+    size_++;
+}
+
+
+
+template <class T> T
+unrolled_node_t<T>::erase(const int i)
+{
+    assert(i >= 0 && i < size_);
+
+    T aux{data_[i]};
+    for (int k{i}; k < size_ - 1; k++)
+        data_[k] = data_[k + 1];
+    size_--;
+
+    return aux;
+}
+
+
+
+// Used to split a full node, and to merge by moving everything (i = 0)
+template <class T> void
+unrolled_node_t<T>::move_tail(const int i, unrolled_node_t<T>* n)
+{
+    assert(i >= 0 && i <= size_ && n->size_ + size_ - i <= UNROLLED_CAPACITY);
+
+    for (int k{i}; k < size_; k++)
+        n->data_[n->size_++] = data_[k];
+    size_ = i;
+}
+
+
+
+// I/O
+template <class T>
+std::ostream& unrolled_node_t<T>::write(std::ostream& os) const
+{
+    for (int i{0}; i < size_; i++)
+        os << data_[i];
+    return os;
+}
+
+
+
+#endif  // UNROLLED_NODET_H_
@@ -0,0 +1,280 @@
+#ifndef UNROLLED_SLLT_H_
+#define UNROLLED_SLLT_H_
+
+#include <iostream>
+#include <cassert>
+
+#include "unrolled_node_t.h"
+
+
+
+// Unrolled singly linked list: the same sequence as sll_t, but every
+// node holds up to UNROLLED_CAPACITY elements in an array. A scan reads
+// contiguous memory and only follows a pointer once per node, instead
+// of taking a dependent cache miss per element.
+//
+// Elements are addressed by (node, index in the node), so the
+// operations of sll_t take that pair instead of a node pointer.
+// Inserting into a full node splits it in two halves, and a node left
+// under half full by an erase is merged with (or refilled from) the
+// next one, so no node is empty and they stay at least half full on
+// average: both are O(UNROLLED_CAPACITY), i.e. O(1). Either can move
+// elements to another node, so the positions held before them are no
+// longer valid.
+template <class T> class unrolled_sll_t
+{
+ public:
+    // constructor
+    unrolled_sll_t(void) : head_(NULL), tail_(NULL), size_(0) {}
+
+    // destructor
+    ~unrolled_sll_t(void);
+
+    // getters
+    unrolled_node_t<T>* get_head(void) const { return head_; };
+    unrolled_node_t<T>* get_tail(void) const { return tail_; };
+    int get_size(void) const { return size_; };
+
+    bool empty(void) const;
+
+    // operations
+    void clear(void);
+    void push_front(const T&);
+    void push_back(const T&);
+    T pop_front(void);
+
+    // the element after number i of node n; the new one can end up in
+    // the next node if n is split
+    void insert_after(unrolled_node_t<T>*, const int, const T&);
+    T erase_after(unrolled_node_t<T>*, const int);
+
+    unrolled_node_t<T>* search(const T&, int&) const;  // node, and index in it
+
+    // I/O
+    std::ostream& write(std::ostream& = std::cout) const;
+
+ private:
+    unrolled_node_t<T>* head_;
+    unrolled_node_t<T>* tail_;
+    int size_;
+
+    void split(unrolled_node_t<T>*);
+    void rebalance(unrolled_node_t<T>*, unrolled_node_t<T>*);
+};
+
+
+
+// destructor
+template <class T>
+unrolled_sll_t<T>::~unrolled_sll_t(void)
+{
+    clear();
+}
+
+
+
+// Check if the list is empty
+template <class T> bool
+unrolled_sll_t<T>::empty(void) const
+{
+    return head_ == NULL;
+}
+
+// -- OPERATIONS --
+
+template <class T> void
+unrolled_sll_t<T>::clear(void)
+{
+    while (head_ != NULL)
+    {
+        unrolled_node_t<T>* aux = head_;
+        head_ = head_->get_next();
+        delete aux;
+    }
+    tail_ = NULL;
+    size_ = 0;
+}
+
+
+
+// Moves the upper half of a full node to a new node right after it
+template <class T> void
+unrolled_sll_t<T>::split(unrolled_node_t<T>* n)
+{
+    unrolled_node_t<T>* aux = new unrolled_node_t<T>;
+    n->move_tail(n->get_size() / 2, aux);
+
+    aux->set_next(n->get_next());
+    n->set_next(aux);
+    if (tail_ == n)
+        tail_ = aux;
+}
+
+
+
+// After an erase in n (prev is the node before it, NULL at the head):
+// an empty n is unlinked, and one under half full takes the elements of
+// the next node if they fit, or one element from it otherwise
+template <class T> void
+unrolled_sll_t<T>::rebalance(unrolled_node_t<T>* prev, unrolled_node_t<T>* n)
+{
+    if (n->get_size() == 0)
+    {
+        if (prev == NULL)
+            head_ = n->get_next();
+        else
+            prev->set_next(n->get_next());
+        if (tail_ == n)
+            tail_ = prev;
+        delete n;
+        return;
+    }
+
+    unrolled_node_t<T>* next = n->get_next();
+    if (n->get_size() >= UNROLLED_CAPACITY / 2 || next == NULL)
+        return;
+
+    if (n->get_size() + next->get_size() <= UNROLLED_CAPACITY)
+    {
+        next->move_tail(0, n);
+        n->set_next(next->get_next());
+        if (tail_ == next)
+            tail_ = n;
+        delete next;
+    }
+    else
+        n->insert(n->get_size(), next->erase(0));
+}
+
+
+
+template <class T> void
+unrolled_sll_t<T>::push_front(const T& data)
+{
+    if (head_ == NULL || head_->full())
+    {
+        unrolled_node_t<T>* aux = new unrolled_node_t<T>;
+        aux->set_next(head_);
+        head_ = aux;
+        if (tail_ == NULL)
+            tail_ = aux;
+    }
+
+    head_->insert(0, data);
+    size_++;
+}
+
+
+
+template <class T> void
+unrolled_sll_t<T>::push_back(const T& data)
+{
+    if (tail_ == NULL || tail_->full())
+    {
+        unrolled_node_t<T>* aux = new unrolled_node_t<T>;
+        if (tail_ == NULL)
+            head_ = aux;
+        else
+            tail_->set_next(aux);
+        tail_ = aux;
+    }
+
+    tail_->insert(tail_->get_size(), data);
+    size_++;
+}
+
+
+
+template <class T> T
+unrolled_sll_t<T>::pop_front(void)
+{
+    assert(!empty());
+
+    T aux{head_->erase(0)};
+    size_--;
+    rebalance(NULL, head_);
+
+    return aux;
+}
+
+
+
+template <class T> void
+unrolled_sll_t<T>::insert_after(unrolled_node_t<T>* n, const int i,
+                                const T& data)
+{
+    assert(n != NULL && i >= 0 && i < n->get_size());
+
+    int pos{i + 1};
+    if (n->full())
+    {
+        split(n);
+        if (pos > n->get_size())
+        {
+            pos -= n->get_size();
+            n = n->get_next();
+        }
+    }
+
+    n->insert(pos, data);
+    size_++;
+}
+
+
+
+// The element that follows is either the next one in n, or the first
+// one of the next node
+template <class T> T
+unrolled_sll_t<T>::erase_after(unrolled_node_t<T>* n, const int i)
+{
+    assert(n != NULL && i >= 0 && i < n->get_size());
+
+    unrolled_node_t<T>* prev{NULL};
+    int pos{i + 1};
+    if (pos == n->get_size())
+    {
+        prev = n;
+        n = n->get_next();
+        pos = 0;
+    }
+
+    assert(n != NULL);
+    T aux{n->erase(pos)};
+    size_--;
+
+    // prev is only needed when n is the next node: otherwise n keeps the
+    // elements before pos, so it cannot be left empty
+    rebalance(prev, n);
+
+    return aux;
+}
+
+
+
+template <class T> unrolled_node_t<T>*
+unrolled_sll_t<T>::search(const T& d, int& i) const
+{
+    for (unrolled_node_t<T>* aux = head_; aux != NULL; aux = aux->get_next())
+        for (i = 0; i < aux->get_size(); i++)
+            if (!(aux->get_data(i) != d))  // the same operator as sll_t
+                return aux;
+
+    i = -1;
+    return NULL;
+}
+
+
+
+// I/O
+template <class T>
+std::ostream& unrolled_sll_t<T>::write(std::ostream& os) const
+{
+    for (unrolled_node_t<T>* aux = head_; aux != NULL; aux = aux->get_next())
+        aux->write(os);
+
+    return os;
+}
+
+
+
+#endif  // UNROLLED_SLLT_H_
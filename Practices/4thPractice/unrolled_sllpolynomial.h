@@ -0,0 +1,159 @@
+#ifndef UNROLLED_SLLPOLYNOMIAL_H_
+#define UNROLLED_SLLPOLYNOMIAL_H_
+
+#include <iostream>
+
+#include "sllpolynomial.h"
+#include "unrolled_sll_t.h"
+
+typedef unrolled_node_t<pair_double_t> UnrolledPolyNode;
+
+
+
+// SllPolynomial on an unrolled list: the same terms, in ascending
+// exponent order, with the same operations (those of
+// sllpolynomial_terms.h) and results. The walks read every node's array
+// and then jump to the next node, so long polynomials are scanned at
+// memory speed rather than one cache miss per term.
+class UnrolledSllPolynomial : public unrolled_sll_t<pair_double_t>
+{
+ public:
+    // constructors
+    UnrolledSllPolynomial(void) : unrolled_sll_t() {};
+    UnrolledSllPolynomial(const vector_t<double>&, const double = EPS);
+    UnrolledSllPolynomial(const SllPolynomial&);
+
+    // destructor
+    ~UnrolledSllPolynomial() {};
+
+    // I/O
+    void Write(std::ostream& = std::cout) const;
+
+    // operations
+    double Eval(const double) const;
+    double Eval(const power_table_t&) const;
+    bool IsEqual(const UnrolledSllPolynomial&, const double = EPS) const;
+    void Sum(const UnrolledSllPolynomial&, UnrolledSllPolynomial&,
+             const double = EPS) const;
+
+    // Extra modification
+    double WeirdSum(const double c, const int i) const;
+};
+
+
+
+// Term cursor (see sllpolynomial_terms.h): a node and an index in it.
+// The terms of a node are read side by side, and the list is only
+// followed once per node
+class unrolled_cursor_t
+{
+ public:
+    // constructors
+    unrolled_cursor_t(const UnrolledPolyNode* node) : node_(node), k_(0) {}
+
+    // getters
+    bool valid(void) const { return node_ != NULL; }
+    int get_inx(void) const { return node_->get_data(k_).get_inx(); }
+    double get_val(void) const { return node_->get_data(k_).get_val(); }
+
+    // operations
+    void next(void)
+    {
+        if (++k_ == node_->get_size())
+        {
+            node_ = node_->get_next();
+            k_ = 0;
+        }
+    }
+
+ private:
+    const UnrolledPolyNode* node_;
+    int k_;
+};
+
+
+
+// constructors
+UnrolledSllPolynomial::UnrolledSllPolynomial(const vector_t<double>& v,
+                                             const double eps)
+{
+    for (int i{0}; i < v.get_size(); ++i)
+        if (IsNotZero(v[i], eps))
+            push_back(pair_double_t(v[i], i));
+}
+
+
+
+UnrolledSllPolynomial::UnrolledSllPolynomial(const SllPolynomial& sllpol)
+{
+    for (SllPolyNode* aux{sllpol.get_head()}; aux != NULL; aux = aux->get_next())
+        push_back(aux->get_data());
+}
+
+
+
+// I/O
+void
+UnrolledSllPolynomial::Write(std::ostream& os) const
+{
+    TermsWrite(os, unrolled_cursor_t(get_head()));
+}
+
+
+
+std::ostream&
+operator<<(std::ostream& os, const UnrolledSllPolynomial& p) {
+    p.Write(os);
+    return os;
+}
+
+
+
+// -- OPERATIONS WITH POLYNOMIALS --
+
+// The running power of TermsEval, carried across the nodes
+double
+UnrolledSllPolynomial::Eval(const double x) const {
+    return TermsEval(unrolled_cursor_t(get_head()), x);
+}
+
+
+
+double
+UnrolledSllPolynomial::Eval(const power_table_t& pt) const {
+    return TermsEval(unrolled_cursor_t(get_head()), pt);
+}
+
+
+
+bool
+UnrolledSllPolynomial::IsEqual(const UnrolledSllPolynomial& pol,
+                               const double eps) const
+{
+    return TermsIsEqual(unrolled_cursor_t(get_head()),
+                        unrolled_cursor_t(pol.get_head()), eps);
+}
+
+
+
+// Merge of both polynomials, appended in ascending order
+void
+UnrolledSllPolynomial::Sum(const UnrolledSllPolynomial& pol,
+                           UnrolledSllPolynomial& polsum, const double eps) const
+{
+    TermsSum(unrolled_cursor_t(get_head()), unrolled_cursor_t(pol.get_head()),
+             [&polsum](const pair_double_t& t) { polsum.push_back(t); }, eps);
+}
+
+
+
+// Extra modification: same as SllPolynomial::WeirdSum
+double
+UnrolledSllPolynomial::WeirdSum(const double c, const int i) const
+{
+    return TermsWeirdSum(unrolled_cursor_t(get_head()), c, i);
+}
+
+
+
+#endif  // UNROLLED_SLLPOLYNOMIAL_H_